@@ -0,0 +1,348 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 John D. Haughton
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//------------------------------------------------------------------------------
+
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define MINESWEEPER_X86 1
+#include <immintrin.h>
+#endif
+
+#include "MineSweeperBitBoard.h"
+
+namespace MineSweeper {
+
+//! Spread the 8 bits of a byte into the least significant bit of 8 bytes
+inline uint64_t spreadBits(unsigned byte)
+{
+   static const std::array<uint64_t, 256> table = []
+   {
+      std::array<uint64_t, 256> t{};
+
+      for(unsigned b = 0; b < 256; ++b)
+      {
+         for(unsigned j = 0; j < 8; ++j)
+         {
+            if((b >> j) & 1) t[b] |= uint64_t(1) << (8 * j);
+         }
+      }
+
+      return t;
+   }();
+
+   return table[byte & 0xFF];
+}
+
+//! Mines in the 3x3 window around every plot one plot at a time, the reference for the kernels below
+//
+//  As for BitBoard::countAdjacent() the window includes the plot itself so
+//  for a safe plot the count is its number of adjacent mines. counts must
+//  hold WIDTH * HEIGHT bytes, stored row by row
+template <unsigned WIDTH, unsigned HEIGHT>
+void countAdjacentScalar(const BitBoard<WIDTH, HEIGHT>& mines, uint8_t* counts)
+{
+   for(unsigned y = 0; y < HEIGHT; ++y)
+   {
+      for(unsigned x = 0; x < WIDTH; ++x)
+      {
+         counts[y * WIDTH + x] = mines.countAdjacent(x, y);
+      }
+   }
+}
+
+//! Mines in the 3x3 window around every plot, a board word at a time
+//
+//  The nine window masks of a word are formed by shifting the rows
+//  above, at and below it, and summed by a bit-sliced adder into four bit
+//  planes that are then spread out into one byte per plot
+template <unsigned WIDTH, unsigned HEIGHT>
+void countAdjacentBitSliced(const BitBoard<WIDTH, HEIGHT>& mines, uint8_t* counts)
+{
+   using Board = BitBoard<WIDTH, HEIGHT>;
+
+   const unsigned WORD_BITS     = Board::WORD_BITS;
+   const unsigned WORDS_PER_ROW = Board::WORDS_PER_ROW;
+
+   // Word i of row y (zero off the board) with its neighbours shifted into line
+   auto shifted = [&](signed y, unsigned i, uint64_t& left, uint64_t& centre, uint64_t& right)
+   {
+      if((y < 0) || (y >= signed(HEIGHT)))
+      {
+         left = centre = right = 0;
+         return;
+      }
+
+      const typename Board::Word* row = mines.row(y);
+
+      uint64_t lo = i > 0                   ? uint64_t(row[i - 1]) >> (WORD_BITS - 1) : 0;
+      uint64_t hi = i < (WORDS_PER_ROW - 1) ? uint64_t(row[i + 1] & 1) << (WORD_BITS - 1) : 0;
+
+      centre = row[i];
+      left   = (centre << 1) | lo;  // plot x - 1 moved to bit x
+      right  = (centre >> 1) | hi;  // plot x + 1 moved to bit x
+   };
+
+   for(unsigned y = 0; y < HEIGHT; ++y)
+   {
+      for(unsigned i = 0; i < WORDS_PER_ROW; ++i)
+      {
+         uint64_t ul, uc, ur, ml, mc, mr, dl, dc, dr;
+
+         shifted(signed(y) - 1, i, ul, uc, ur);
+         shifted(signed(y),     i, ml, mc, mr);
+         shifted(signed(y) + 1, i, dl, dc, dr);
+
+         // A full adder for each row
+         uint64_t ones_u = ul ^ uc ^ ur;
+         uint64_t twos_u = (ul & uc) | (ur & (ul ^ uc));
+         uint64_t ones_m = ml ^ mc ^ mr;
+         uint64_t twos_m = (ml & mc) | (mr & (ml ^ mc));
+         uint64_t ones_d = dl ^ dc ^ dr;
+         uint64_t twos_d = (dl & dc) | (dr & (dl ^ dc));
+
+         uint64_t bit0   = ones_u ^ ones_d ^ ones_m;
+         uint64_t twos_o = (ones_u & ones_d) | (ones_m & (ones_u ^ ones_d));
+
+         uint64_t twos   = twos_u ^ twos_d ^ twos_m;
+         uint64_t fours  = (twos_u & twos_d) | (twos_m & (twos_u ^ twos_d));
+
+         uint64_t bit1   = twos ^ twos_o;
+         uint64_t fours2 = twos & twos_o;
+
+         uint64_t bit2   = fours ^ fours2;
+         uint64_t bit3   = fours & fours2;
+
+         unsigned x0 = i * WORD_BITS;
+         unsigned n  = WIDTH - x0 < WORD_BITS ? WIDTH - x0 : WORD_BITS;
+
+         uint8_t* out = counts + y * WIDTH + x0;
+
+         for(unsigned x = 0; x < n; x += 8)
+         {
+            uint64_t bytes = spreadBits(unsigned(bit0 >> x))
+                           | spreadBits(unsigned(bit1 >> x)) << 1
+                           | spreadBits(unsigned(bit2 >> x)) << 2
+                           | spreadBits(unsigned(bit3 >> x)) << 3;
+
+            memcpy(out + x, &bytes, n - x < 8 ? n - x : 8);
+         }
+      }
+   }
+}
+
+#if defined(MINESWEEPER_X86)
+
+//! Mines in the 3x3 window around every plot, 32 plots at a time in AVX2 byte lanes
+//
+//  Rows are unpacked to one byte per plot, with a zero border, into a
+//  rolling window of three rows and the window summed with byte adds of
+//  unaligned loads
+template <unsigned WIDTH, unsigned HEIGHT>
+__attribute__((target("avx2")))
+void countAdjacentAVX2(const BitBoard<WIDTH, HEIGHT>& mines, uint8_t* counts)
+{
+   using Board = BitBoard<WIDTH, HEIGHT>;
+
+   // A plot of border either side and room for unpacking 8 plots at a time
+   const unsigned STRIDE = (WIDTH + 2 + 8 + 63) & ~63u;
+
+   static thread_local std::vector<uint8_t> buffer;
+   buffer.assign(3 * STRIDE, 0);
+
+   auto unpack = [&](signed y, uint8_t* dst)
+   {
+      if((y < 0) || (y >= signed(HEIGHT)))
+      {
+         memset(dst, 0, STRIDE);
+         return;
+      }
+
+      const typename Board::Word* row = mines.row(y);
+
+      for(unsigned x = 0; x < WIDTH; x += 8)
+      {
+         uint64_t word  = row[x / Board::WORD_BITS];
+         uint64_t bytes = spreadBits(unsigned(word >> (x % Board::WORD_BITS)));
+
+         memcpy(dst + 1 + x, &bytes, 8);
+      }
+
+      // clear anything unpacked beyond the edge of the board
+      memset(dst + 1 + WIDTH, 0, STRIDE - 1 - WIDTH);
+   };
+
+   uint8_t* rows[3] = {&buffer[0], &buffer[STRIDE], &buffer[2 * STRIDE]};
+
+   unpack(-1, rows[0]);
+   unpack(0,  rows[1]);
+
+   for(unsigned y = 0; y < HEIGHT; ++y)
+   {
+      unpack(signed(y) + 1, rows[2]);
+
+      const uint8_t* up   = rows[0];
+      const uint8_t* mid  = rows[1];
+      const uint8_t* down = rows[2];
+      uint8_t*       out  = counts + y * WIDTH;
+
+      unsigned x = 0;
+
+      for(; x + 32 <= WIDTH; x += 32)
+      {
+         const __m256i* u = reinterpret_cast<const __m256i*>(up + x);
+         const __m256i* m = reinterpret_cast<const __m256i*>(mid + x);
+         const __m256i* d = reinterpret_cast<const __m256i*>(down + x);
+
+         // u, m and d point at the plot to the left of x
+         __m256i sum = _mm256_add_epi8(_mm256_loadu_si256(u),
+                                       _mm256_loadu_si256(reinterpret_cast<const __m256i*>(up + x + 1)));
+         sum = _mm256_add_epi8(sum, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(up + x + 2)));
+         sum = _mm256_add_epi8(sum, _mm256_loadu_si256(m));
+         sum = _mm256_add_epi8(sum, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(mid + x + 1)));
+         sum = _mm256_add_epi8(sum, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(mid + x + 2)));
+         sum = _mm256_add_epi8(sum, _mm256_loadu_si256(d));
+         sum = _mm256_add_epi8(sum, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(down + x + 1)));
+         sum = _mm256_add_epi8(sum, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(down + x + 2)));
+
+         _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + x), sum);
+      }
+
+      for(; x < WIDTH; ++x)
+      {
+         out[x] = up[x]   + up[x + 1]   + up[x + 2] +
+                  mid[x]  + mid[x + 1]  + mid[x + 2] +
+                  down[x] + down[x + 1] + down[x + 2];
+      }
+
+      uint8_t* oldest = rows[0];
+      rows[0] = rows[1];
+      rows[1] = rows[2];
+      rows[2] = oldest;
+   }
+}
+
+#endif
+
+//! Mines in the 3x3 window around every plot using the fastest kernel for this CPU
+template <unsigned WIDTH, unsigned HEIGHT>
+void countAdjacent(const BitBoard<WIDTH, HEIGHT>& mines, uint8_t* counts)
+{
+#if defined(MINESWEEPER_X86)
+   static const bool has_avx2 = __builtin_cpu_supports("avx2");
+
+   // The byte lanes only pay off once a row fills a vector
+   if(has_avx2 && (WIDTH >= 64))
+   {
+      countAdjacentAVX2(mines, counts);
+      return;
+   }
+#endif
+
+   countAdjacentBitSliced(mines, counts);
+}
+
+//! Bechtel's Board Benchmark Value, the least number of clicks that clears a board
+//
+//  Each opening, a connected region of plots with no adjacent mines, takes
+//  one click and also reveals its border. Every other safe plot takes a
+//  click of its own
+template <unsigned WIDTH, unsigned HEIGHT>
+unsigned getBoardValue(const BitBoard<WIDTH, HEIGHT>& mines)
+{
+   // Kept off the stack as boards may be large
+   std::vector<uint8_t> counts(WIDTH * HEIGHT);
+   countAdjacent(mines, counts.data());
+
+   enum : uint8_t { CLICK, OPENING, VISITED, REVEALED };
+
+   std::vector<uint8_t> plot(WIDTH * HEIGHT, CLICK);
+
+   for(unsigned y = 0; y < HEIGHT; ++y)
+   {
+      for(unsigned x = 0; x < WIDTH; ++x)
+      {
+         if(mines.test(x, y))
+            plot[y * WIDTH + x] = REVEALED;
+         else if(counts[y * WIDTH + x] == 0)
+            plot[y * WIDTH + x] = OPENING;
+      }
+   }
+
+   std::vector<uint32_t> stack;
+   unsigned              value = 0;
+
+   for(uint32_t index = 0; index < WIDTH * HEIGHT; ++index)
+   {
+      if(plot[index] != OPENING) continue;
+
+      // One click for the opening, which reveals it and its border
+      ++value;
+      plot[index] = VISITED;
+      stack.push_back(index);
+
+      while(!stack.empty())
+      {
+         signed plot_x = stack.back() % WIDTH;
+         signed plot_y = stack.back() / WIDTH;
+         stack.pop_back();
+
+         for(signed scan_y = plot_y - 1; scan_y <= plot_y + 1; ++scan_y)
+         {
+            for(signed scan_x = plot_x - 1; scan_x <= plot_x + 1; ++scan_x)
+            {
+               if((scan_x < 0) || (scan_x >= signed(WIDTH)) || (scan_y < 0) || (scan_y >= signed(HEIGHT)))
+               {
+                  continue;
+               }
+
+               uint8_t& scan = plot[scan_y * WIDTH + scan_x];
+
+               if(scan == OPENING)
+               {
+                  scan = VISITED;
+                  stack.push_back(scan_y * WIDTH + scan_x);
+               }
+               else if(scan == CLICK)
+               {
+                  scan = REVEALED;
+               }
+            }
+         }
+      }
+   }
+
+   // Safe plots not revealed by any opening take a click each
+   for(uint8_t p : plot)
+   {
+      if(p == CLICK) ++value;
+   }
+
+   return value;
+}
+
+} // namespace MineSweeper
@@ -0,0 +1,478 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 John D. Haughton
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//------------------------------------------------------------------------------
+
+
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+#include "MineSweeperGame.h"
+#include "MineSweeperPlot.h"
+#include "MineSweeperRandom.h"
+
+namespace MineSweeper {
+
+//! Many games of one size played in lockstep, stored as a struct of arrays
+//
+//  Games are interleaved in blocks of LANES. Each per-plot array holds plot 0
+//  of every game in a block, then plot 1 and so on, so working on the same
+//  plot of many games reads consecutive bytes that vectorize, while the
+//  plots of one game being flood filled stay within a few KB. All the arrays
+//  are carved from a single arena allocation.
+//
+//  Game i plays exactly as a Game reset with seed + i
+template <unsigned WIDTH, unsigned HEIGHT>
+class GameBatch
+{
+public:
+   static const unsigned LANES   = 32;      //!< Games interleaved in each block
+   static const unsigned PLOTS   = WIDTH * HEIGHT;
+   static const uint16_t NO_MOVE = 0xFFFF;  //!< Plot index for a game to sit out a step
+
+   static_assert(PLOTS < NO_MOVE, "Board too large for 16-bit plot indices");
+   static_assert(std::is_trivially_destructible<Random>::value, "Random is kept in the arena");
+
+   GameBatch(unsigned number_of_games_, unsigned number_of_mines_,
+             uint64_t seed = 1, SafeZone safe_zone_ = SAFE_PLOT)
+      : number_of_games(number_of_games_)
+      , number_of_blocks((number_of_games_ + LANES - 1) / LANES)
+      , number_of_mines(number_of_mines_)
+      , safe_zone(safe_zone_)
+   {
+      size_t lanes = size_t(number_of_blocks) * LANES;
+      size_t bytes = 0;
+
+      auto carve = [&bytes](size_t size)
+      {
+         size_t offset = bytes;
+         bytes += (size + sizeof(Line) - 1) & ~(sizeof(Line) - 1);
+         return offset;
+      };
+
+      size_t state_at    = carve(lanes * PLOTS);
+      size_t mine_at     = carve(lanes * PLOTS);
+      size_t adjacent_at = carve(lanes * PLOTS);
+      size_t progress_at = carve(lanes);
+      size_t flags_at    = carve(lanes * sizeof(uint16_t));
+      size_t holes_at    = carve(lanes * sizeof(uint16_t));
+      size_t random_at   = carve(lanes * sizeof(Random));
+
+      arena.reset(new Line[bytes / sizeof(Line)]);
+
+      uint8_t* base = arena[0].bytes;
+
+      state    = base + state_at;
+      mine     = base + mine_at;
+      adjacent = base + adjacent_at;
+      progress = base + progress_at;
+      flags    = reinterpret_cast<uint16_t*>(base + flags_at);
+      holes    = reinterpret_cast<uint16_t*>(base + holes_at);
+      random   = reinterpret_cast<Random*>(base + random_at);
+
+      for(size_t i = 0; i < lanes; ++i) new (&random[i]) Random;
+
+      // Spare lanes in the last block are never in play
+      std::memset(progress, DETONATED, lanes);
+
+      dig_stack.reserve(PLOTS);
+
+      reset(seed);
+   }
+
+   //! Number of games
+   unsigned size() const { return number_of_games; }
+
+   //! Width of every board
+   static unsigned getWidth() { return WIDTH; }
+
+   //! Height of every board
+   static unsigned getHeight() { return HEIGHT; }
+
+   //! Start a new game in every slot, game i from seed + i
+   void reset(uint64_t seed)
+   {
+      size_t lanes = size_t(number_of_blocks) * LANES;
+
+      std::memset(state, UNDUG, lanes * PLOTS);
+      std::memset(mine, 0, lanes * PLOTS);
+
+      for(unsigned game = 0; game < number_of_games; ++game)
+      {
+         random[game].seed(seed + game);
+         plant(game, nullptr, 0);
+
+         progress[game] = RESET;
+         flags[game]    = uint16_t(number_of_mines);
+         holes[game]    = 0;
+      }
+
+      for(unsigned block = 0; block < number_of_blocks; ++block) setAdjacentMines(block);
+   }
+
+   //! Dig the same plot in every game still in play
+   void digHole(unsigned x, unsigned y)
+   {
+      unsigned plot = y * WIDTH + x;
+
+      settleFirstDigs([plot](unsigned) { return plot; });
+
+      for(unsigned block = 0; block < number_of_blocks; ++block)
+      {
+         const uint8_t* block_state    = &state[index(block * LANES, plot)];
+         const uint8_t* block_progress = &progress[block * LANES];
+
+         // Branch free over the lanes, only the games that dig go on to the scalar path
+         uint32_t digging = 0;
+
+         for(unsigned lane = 0; lane < LANES; ++lane)
+         {
+            digging |= uint32_t((block_progress[lane] <= CLEARING) & (block_state[lane] == UNDUG)) << lane;
+         }
+
+         for(; digging != 0; digging &= digging - 1)
+         {
+            dig(block * LANES + __builtin_ctz(digging), plot);
+         }
+      }
+   }
+
+   //! Dig one plot in each game still in play, plots[i] is y * WIDTH + x for game i or NO_MOVE
+   void digHoles(const uint16_t* plots)
+   {
+      settleFirstDigs([plots](unsigned game) { return plots[game]; });
+
+      for(unsigned game = 0; game < number_of_games; ++game)
+      {
+         unsigned plot = plots[game];
+
+         if((plot != NO_MOVE) && (progress[game] <= CLEARING) && (state[index(game, plot)] == UNDUG))
+         {
+            dig(game, plot);
+         }
+      }
+   }
+
+   //! Plant or unplant a flag in an undug plot of one game
+   void plantUnplantFlag(unsigned game, unsigned x, unsigned y)
+   {
+      if(progress[game] != CLEARING) return;
+
+      uint8_t& plot_state = state[index(game, y * WIDTH + x)];
+
+      if((plot_state == UNDUG) && (flags[game] > 0))
+      {
+         plot_state = FLAG;
+         --flags[game];
+         checkIfCleared(game);
+      }
+      else if(plot_state == FLAG)
+      {
+         plot_state = UNDUG;
+         ++flags[game];
+      }
+   }
+
+   //! Progress of one game
+   Progress getProgress(unsigned game) const { return Progress(progress[game]); }
+
+   //! Number of flags available in one game
+   unsigned getNumberOfFlags(unsigned game) const { return flags[game]; }
+
+   //! State of a plot in one game
+   State getPlotState(unsigned game, unsigned x, unsigned y, bool& is_mined) const
+   {
+      size_t i = index(game, y * WIDTH + x);
+      is_mined = mine[i] != 0;
+      return State(state[i]);
+   }
+
+   //! Mines in the 3x3 window around a plot in one game, including the plot itself
+   unsigned getNumberOfAdjacentMines(unsigned game, unsigned x, unsigned y) const
+   {
+      return adjacent[index(game, y * WIDTH + x)];
+   }
+
+   //! Number of games at each Progress value
+   std::array<unsigned, 4> countProgress() const
+   {
+      std::array<unsigned, 4> count{};
+
+      for(unsigned value = RESET; value <= CLEARED; ++value)
+      {
+         count[value] = countEqual(value);
+      }
+
+      // Spare lanes in the last block are always DETONATED
+      count[DETONATED] -= number_of_blocks * LANES - number_of_games;
+
+      return count;
+   }
+
+   //! Number of games not yet won or lost
+   unsigned getNumberInPlay() const
+   {
+      return countEqual(RESET) + countEqual(CLEARING);
+   }
+
+private:
+   struct alignas(64) Line
+   {
+      uint8_t bytes[64];
+   };
+
+   //! Offset of a plot of a game in the per-plot arrays
+   static size_t index(unsigned game, unsigned plot)
+   {
+      return base(game) + plot * LANES;
+   }
+
+   //! Offset of plot 0 of a game, later plots are LANES apart
+   static size_t base(unsigned game)
+   {
+      return size_t(game / LANES) * PLOTS * LANES + game % LANES;
+   }
+
+   //! Number of lanes, including spare lanes, with a given progress
+   //
+   //  Eight games at a time in a 64-bit word. A byte of the XOR with the
+   //  value is zero where the game matches, each zero byte leaves a 1 in the
+   //  bottom bit of that byte and the multiply sums them into the top byte
+   unsigned countEqual(unsigned value) const
+   {
+      const uint64_t LOW  = 0x7F7F7F7F7F7F7F7Full;
+      const uint64_t ONES = 0x0101010101010101ull;
+
+      unsigned n = 0;
+
+      for(size_t i = 0; i < size_t(number_of_blocks) * LANES; i += 8)
+      {
+         uint64_t word;
+         std::memcpy(&word, &progress[i], sizeof(word));
+
+         uint64_t diff    = word ^ (value * ONES);
+         uint64_t nonzero = ((diff & LOW) + LOW) | diff;
+
+         n += unsigned((((~nonzero & ~LOW) >> 7) * ONES) >> 56);
+      }
+
+      return n;
+   }
+
+   //! Apply the safe zone to every game about to make its first dig
+   //
+   //  Done for all games before any digging so that the adjacent counts of
+   //  each block re-planted are recomputed once
+   template <typename PLOT_OF>
+   void settleFirstDigs(PLOT_OF plotOf)
+   {
+      for(unsigned block = 0; block < number_of_blocks; ++block)
+      {
+         bool replanted = false;
+
+         for(unsigned lane = 0; lane < LANES; ++lane)
+         {
+            unsigned game = block * LANES + lane;
+
+            if((game < number_of_games) && (progress[game] == RESET) && (plotOf(game) != NO_MOVE))
+            {
+               replanted |= clearSafeZone(game, plotOf(game));
+            }
+         }
+
+         if(replanted) setAdjacentMines(block);
+      }
+   }
+
+   //! Dig an undug plot in a game that is in play
+   void dig(unsigned game, unsigned plot)
+   {
+      if(progress[game] == RESET)
+      {
+         tryDig(game, plot);
+         progress[game] = CLEARING;
+      }
+      else if(mine[index(game, plot)])
+      {
+         state[index(game, plot)] = EXPLOSION;
+         showMines(game);
+         progress[game] = DETONATED;
+      }
+      else
+      {
+         tryDig(game, plot);
+         checkIfCleared(game);
+      }
+   }
+
+   //! Dig the plot and, if it has no adjacent mines, the region around it
+   void tryDig(unsigned game, unsigned plot)
+   {
+      size_t offset = base(game);
+
+      if(!digPlot(game, offset, plot)) return;
+
+      dig_stack.clear();
+      dig_stack.push_back(uint16_t(plot));
+
+      while(!dig_stack.empty())
+      {
+         unsigned p = dig_stack.back();
+         dig_stack.pop_back();
+
+         signed plot_x = p % WIDTH;
+         signed plot_y = p / WIDTH;
+
+         for(signed scan_y = plot_y - 1; scan_y <= plot_y + 1; ++scan_y)
+         {
+            for(signed scan_x = plot_x - 1; scan_x <= plot_x + 1; ++scan_x)
+            {
+               if((scan_x >= 0) && (scan_x < signed(WIDTH)) && (scan_y >= 0) && (scan_y < signed(HEIGHT)) &&
+                  digPlot(game, offset, scan_y * WIDTH + scan_x))
+               {
+                  dig_stack.push_back(uint16_t(scan_y * WIDTH + scan_x));
+               }
+            }
+         }
+      }
+   }
+
+   //! Dig a single plot, returns true if the plots around it should be dug too
+   bool digPlot(unsigned game, size_t offset, unsigned plot)
+   {
+      size_t i = offset + plot * LANES;
+
+      if((state[i] != UNDUG) || mine[i]) return false;
+
+      state[i] = HOLE;
+      ++holes[game];
+
+      return adjacent[i] == 0;
+   }
+
+   void checkIfCleared(unsigned game)
+   {
+      if((holes[game] + number_of_mines - flags[game]) == PLOTS) progress[game] = CLEARED;
+   }
+
+   void showMines(unsigned game)
+   {
+      for(size_t i = base(game); i < base(game) + PLOTS * LANES; i += LANES)
+      {
+         if(mine[i] && (state[i] != EXPLOSION)) state[i] = HOLE;
+      }
+   }
+
+   void plant(unsigned game, const uint64_t* excluded, unsigned number_excluded)
+   {
+      plantMines(random[game], PLOTS, number_of_mines, excluded, number_excluded,
+                 [this, game](uint64_t plot) { return mine[index(game, plot)] != 0; },
+                 [this, game](uint64_t plot) { mine[index(game, plot)] = 1; });
+   }
+
+   //! Re-plant, once, if there are any mines in the safe zone, returns true if re-planted
+   bool clearSafeZone(unsigned game, unsigned plot)
+   {
+      uint64_t zone[9];
+      unsigned n = getSafeZone(safe_zone, plot % WIDTH, plot / WIDTH, WIDTH, HEIGHT, zone);
+
+      if((PLOTS - n) < number_of_mines)
+      {
+         n = getSafeZone(SAFE_PLOT, plot % WIDTH, plot / WIDTH, WIDTH, HEIGHT, zone);
+      }
+
+      for(unsigned i = 0; i < n; ++i)
+      {
+         if(mine[index(game, zone[i])])
+         {
+            for(unsigned p = 0; p < PLOTS; ++p) mine[index(game, p)] = 0;
+
+            plant(game, zone, n);
+            return true;
+         }
+      }
+
+      return false;
+   }
+
+   //! Count the mines in the 3x3 window of every plot for all the games of a block at once
+   //
+   //  The lanes are added eight at a time as 64-bit words, a count never
+   //  exceeds nine so no byte carries into the next
+   void setAdjacentMines(unsigned block)
+   {
+      const unsigned WORDS = LANES / 8;
+
+      const uint8_t* block_mine     = &mine[index(block * LANES, 0)];
+      uint8_t*       block_adjacent = &adjacent[index(block * LANES, 0)];
+
+      for(signed y = 0; y < signed(HEIGHT); ++y)
+      {
+         for(signed x = 0; x < signed(WIDTH); ++x)
+         {
+            uint64_t sum[WORDS] = {};
+
+            for(signed scan_y = y - 1; scan_y <= y + 1; ++scan_y)
+            {
+               for(signed scan_x = x - 1; scan_x <= x + 1; ++scan_x)
+               {
+                  if((scan_x < 0) || (scan_x >= signed(WIDTH)) || (scan_y < 0) || (scan_y >= signed(HEIGHT)))
+                     continue;
+
+                  const uint8_t* in = &block_mine[(scan_y * WIDTH + scan_x) * LANES];
+
+                  for(unsigned word = 0; word < WORDS; ++word)
+                  {
+                     uint64_t lanes;
+                     std::memcpy(&lanes, in + word * 8, sizeof(lanes));
+                     sum[word] += lanes;
+                  }
+               }
+            }
+
+            std::memcpy(&block_adjacent[(y * WIDTH + x) * LANES], sum, sizeof(sum));
+         }
+      }
+   }
+
+   unsigned                number_of_games;
+   unsigned                number_of_blocks;
+   unsigned                number_of_mines;
+   SafeZone                safe_zone;
+   std::unique_ptr<Line[]> arena;
+   uint8_t*                state;     //!< Visible State of each plot
+   uint8_t*                mine;      //!< 1 for a mined plot
+   uint8_t*                adjacent;  //!< Mines in the 3x3 window of each plot
+   uint8_t*                progress;  //!< Progress of each game
+   uint16_t*               flags;     //!< Flags available in each game
+   uint16_t*               holes;     //!< Holes dug in each game
+   Random*                 random;    //!< Generator for each game
+   std::vector<uint16_t>   dig_stack;
+};
+
+} // namespace MineSweeper
@@ -0,0 +1,263 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 John D. Haughton
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//------------------------------------------------------------------------------
+
+
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <type_traits>
+
+namespace MineSweeper {
+
+//! Smallest unsigned word that holds a row of the given width (64 bits max)
+template <unsigned WIDTH>
+using RowWord = typename std::conditional<
+   WIDTH <= 8,  uint8_t, typename std::conditional<
+   WIDTH <= 16, uint16_t, typename std::conditional<
+   WIDTH <= 32, uint32_t, uint64_t>::type>::type>::type;
+
+//! Count the set bits in a word
+inline unsigned popCount(uint64_t word) { return __builtin_popcountll(word); }
+
+//! One bit per plot, stored row by row with one or more words per row
+template <unsigned WIDTH, unsigned HEIGHT>
+class BitBoard
+{
+public:
+   using Word = RowWord<WIDTH>;
+
+   static const unsigned WORD_BITS     = sizeof(Word) * 8;
+   static const unsigned WORDS_PER_ROW = (WIDTH + WORD_BITS - 1) / WORD_BITS;
+
+   BitBoard() = default;
+
+   //! Test the bit for the given location
+   bool test(unsigned x, unsigned y) const
+   {
+      return (word[index(x, y)] >> (x % WORD_BITS)) & 1;
+   }
+
+   //! Set the bit for the given location
+   void set(unsigned x, unsigned y)
+   {
+      word[index(x, y)] |= Word(1) << (x % WORD_BITS);
+   }
+
+   //! Clear the bit for the given location
+   void clear(unsigned x, unsigned y)
+   {
+      word[index(x, y)] &= ~(Word(1) << (x % WORD_BITS));
+   }
+
+   //! Clear all bits
+   void clearAll() { word.fill(0); }
+
+   //! Set all bits that correspond to a location on the board
+   void setAll()
+   {
+      for(unsigned y = 0; y < HEIGHT; ++y)
+      {
+         for(unsigned i = 0; i < WORDS_PER_ROW; ++i)
+         {
+            word[y * WORDS_PER_ROW + i] = rowMask(i);
+         }
+      }
+   }
+
+   //! Check if any bit is set
+   bool any() const
+   {
+      Word acc = 0;
+      for(const auto& w : word) acc |= w;
+      return acc != 0;
+   }
+
+   //! Total number of set bits
+   unsigned count() const
+   {
+      unsigned total = 0;
+      for(const auto& w : word) total += popCount(w);
+      return total;
+   }
+
+   //! The 3x3 window centred on the given location as a 9-bit mask, a row at a time
+   unsigned getWindow(signed x, signed y) const
+   {
+      unsigned window = 0;
+
+      for(signed dy = -1; dy <= 1; ++dy)
+      {
+         signed scan_y = y + dy;
+
+         if((scan_y < 0) || (scan_y >= signed(HEIGHT))) continue;
+
+         window |= getBits3(x - 1, scan_y) << (3 * (dy + 1));
+      }
+
+      return window;
+   }
+
+   //! Number of bits set in the 3x3 window centred on the given location
+   unsigned countAdjacent(signed x, signed y) const
+   {
+      return popCount(getWindow(x, y));
+   }
+
+   //! Set each bit that is set, or has a set neighbour, in this board
+   BitBoard dilate() const
+   {
+      BitBoard spread;
+      BitBoard result;
+
+      for(unsigned y = 0; y < HEIGHT; ++y)
+      {
+         for(unsigned i = 0; i < WORDS_PER_ROW; ++i)
+         {
+            unsigned n = y * WORDS_PER_ROW + i;
+
+            // carry bits across word boundaries for rows wider than 64
+            Word w       = word[n];
+            Word from_lo = i > 0                   ? word[n - 1] >> (WORD_BITS - 1) : 0;
+            Word from_hi = i < (WORDS_PER_ROW - 1) ? Word(word[n + 1] << (WORD_BITS - 1)) : 0;
+
+            spread.word[n] = (w | Word(w << 1) | (w >> 1) | from_lo | from_hi) & rowMask(i);
+         }
+      }
+
+      for(unsigned y = 0; y < HEIGHT; ++y)
+      {
+         for(unsigned i = 0; i < WORDS_PER_ROW; ++i)
+         {
+            unsigned n = y * WORDS_PER_ROW + i;
+
+            Word w = spread.word[n];
+            if(y > 0)              w |= spread.word[n - WORDS_PER_ROW];
+            if(y < (HEIGHT - 1))   w |= spread.word[n + WORDS_PER_ROW];
+
+            result.word[n] = w;
+         }
+      }
+
+      return result;
+   }
+
+   //! Call fn(x, y) for every set bit
+   template <typename FN>
+   void forEach(FN fn) const
+   {
+      for(unsigned y = 0; y < HEIGHT; ++y)
+      {
+         for(unsigned i = 0; i < WORDS_PER_ROW; ++i)
+         {
+            uint64_t w = word[y * WORDS_PER_ROW + i];
+
+            while(w != 0)
+            {
+               unsigned bit = __builtin_ctzll(w);
+               fn(i * WORD_BITS + bit, y);
+               w &= w - 1;
+            }
+         }
+      }
+   }
+
+   //! Direct access to the words of a row
+   Word*       row(unsigned y)       { return &word[y * WORDS_PER_ROW]; }
+   const Word* row(unsigned y) const { return &word[y * WORDS_PER_ROW]; }
+
+   BitBoard operator~() const
+   {
+      BitBoard result;
+      for(unsigned y = 0; y < HEIGHT; ++y)
+      {
+         for(unsigned i = 0; i < WORDS_PER_ROW; ++i)
+         {
+            unsigned n = y * WORDS_PER_ROW + i;
+            result.word[n] = ~word[n] & rowMask(i);
+         }
+      }
+      return result;
+   }
+
+   BitBoard& operator|=(const BitBoard& rhs)
+   {
+      for(unsigned n = 0; n < word.size(); ++n) word[n] |= rhs.word[n];
+      return *this;
+   }
+
+   BitBoard& operator&=(const BitBoard& rhs)
+   {
+      for(unsigned n = 0; n < word.size(); ++n) word[n] &= rhs.word[n];
+      return *this;
+   }
+
+   BitBoard operator|(const BitBoard& rhs) const { return BitBoard(*this) |= rhs; }
+   BitBoard operator&(const BitBoard& rhs) const { return BitBoard(*this) &= rhs; }
+
+   bool operator==(const BitBoard& rhs) const { return word == rhs.word; }
+   bool operator!=(const BitBoard& rhs) const { return word != rhs.word; }
+
+private:
+   static unsigned index(unsigned x, unsigned y)
+   {
+      assert((x < WIDTH) && (y < HEIGHT));
+
+      return y * WORDS_PER_ROW + x / WORD_BITS;
+   }
+
+   //! Mask of the valid bits in the i'th word of a row
+   static Word rowMask(unsigned i)
+   {
+      unsigned bits = WIDTH - i * WORD_BITS;
+      return bits >= WORD_BITS ? Word(~Word(0)) : Word((Word(1) << bits) - 1);
+   }
+
+   //! Three bits starting at x (which may be -1) in the given row
+   unsigned getBits3(signed x, unsigned y) const
+   {
+      unsigned bits = 0;
+
+      if((x >= 0) && (unsigned(x) % WORD_BITS <= (WORD_BITS - 3)))
+      {
+         // fast path, all three bits are in the same word
+         bits = (word[y * WORDS_PER_ROW + x / WORD_BITS] >> (x % WORD_BITS)) & 0b111;
+      }
+      else
+      {
+         for(signed scan_x = x; scan_x <= x + 2; ++scan_x)
+         {
+            if((scan_x >= 0) && (scan_x < signed(WIDTH)) && test(scan_x, y))
+            {
+               bits |= 1 << (scan_x - x);
+            }
+         }
+      }
+
+      return bits;
+   }
+
+   std::array<Word, WORDS_PER_ROW * HEIGHT> word{};
+};
+
+} // namespace MineSweeper
@@ -0,0 +1,315 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 John D. Haughton
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//------------------------------------------------------------------------------
+
+
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+#include "MineSweeperGame.h"
+#include "MineSweeperPlot.h"
+#include "MineSweeperRandom.h"
+
+namespace MineSweeper {
+
+//! Mine sweeper game with the board size chosen at run-time
+//
+//  Same behaviour and API as Game<WIDTH,HEIGHT> but the field is a single
+//  heap allocation and the counters are 64-bit so that very large boards
+//  can be played without recompiling
+class DynamicGame
+{
+public:
+   DynamicGame(unsigned width_, unsigned height_, uint64_t number_of_mines_, uint64_t seed = 1)
+      : width(width_)
+      , height(height_)
+      , number_of_mines(number_of_mines_)
+      , random(seed)
+      , field(uint64_t(width_) * height_)
+   {
+      assert(number_of_mines <= field.size());
+
+      reset();
+   }
+
+   //! Width of the board
+   unsigned getWidth() const { return width; }
+
+   //! Height of the board
+   unsigned getHeight() const { return height; }
+
+   //! Return current game state
+   Progress getProgress() const { return progress; }
+
+   //! Number of available flags
+   uint64_t getNumberOfFlags() const { return number_of_flags; }
+
+   //! Number of ticks that the game has been underway
+   unsigned getNumberOfTicks() const { return number_of_ticks; }
+
+   //! State of plot at the given location
+   State getPlotState(unsigned x, unsigned y, bool& mine) const
+   {
+      return getCell(x, y).plot.getState(mine);
+   }
+
+   //! Total number of mines adjacent to the given location
+   unsigned getNumberOfAdjacentMines(signed x, signed y) const
+   {
+      return getCell(x, y).adjacent;
+   }
+
+   //! Choose how much of the board is kept clear of mines for the first dig
+   void setSafeZone(SafeZone safe_zone_) { safe_zone = safe_zone_; }
+
+   //! Reset ready for new game with the layout generated from the given seed
+   void reset(uint64_t seed)
+   {
+      random.seed(seed);
+      reset();
+   }
+
+   //! Reset ready for new game
+   void reset()
+   {
+      clearField();
+      plant(nullptr, 0);
+
+      number_of_flags = number_of_mines;
+      number_of_holes = 0;
+      number_of_ticks = 0;
+      progress        = RESET;
+   }
+
+   //! Plant or unplant a flag in an undug plot
+   void plantUnplantFlag(unsigned x, unsigned y)
+   {
+      if(progress != CLEARING)
+      {
+         return;
+      }
+
+      if(getCell(x, y).plot.toggleFlag(number_of_flags))
+      {
+         checkIfCleared();
+      }
+   }
+
+   //! Dig a hole in an undug plot
+   void digHole(unsigned x, unsigned y)
+   {
+      Plot& plot = getCell(x, y).plot;
+
+      if(progress == RESET)
+      {
+         clearSafeZone(x, y);
+
+         tryDig(x, y);
+         progress = CLEARING;
+         return;
+      }
+      else if(progress != CLEARING)
+      {
+         return;
+      }
+
+      if(plot.isUndug())
+      {
+         if(plot.startDig())
+         {
+            tryDig(x, y);
+            checkIfCleared();
+         }
+         else
+         {
+            showMines();
+            progress = DETONATED;
+         }
+      }
+   }
+
+   //! Increment game timer
+   void tick()
+   {
+      if(progress == CLEARING)
+      {
+         ++number_of_ticks;
+      }
+   }
+
+private:
+   //! A plot and the number of mines adjacent to it
+   struct Cell
+   {
+      Plot    plot;
+      uint8_t adjacent{0};
+   };
+
+   bool isValidPlot(signed x, signed y) const
+   {
+      return (x >= 0) && (x < signed(width)) &&
+             (y >= 0) && (y < signed(height));
+   }
+
+   void checkIfCleared()
+   {
+      if((number_of_holes + number_of_mines - number_of_flags) == field.size())
+      {
+         progress = CLEARED;
+      }
+   }
+
+   //! Dig the given plot and, if it has no adjacent mines, the region around it
+   void tryDig(signed x, signed y)
+   {
+      if(!digPlot(x, y)) return;
+
+      dig_stack.clear();
+      dig_stack.push_back(index(x, y));
+
+      while(!dig_stack.empty())
+      {
+         uint64_t plot_index = dig_stack.back();
+         dig_stack.pop_back();
+
+         signed plot_x = plot_index % width;
+         signed plot_y = plot_index / width;
+
+         for(signed scan_y = plot_y - 1; scan_y <= plot_y + 1; ++scan_y)
+         {
+            for(signed scan_x = plot_x - 1; scan_x <= plot_x + 1; ++scan_x)
+            {
+               if(isValidPlot(scan_x, scan_y) && digPlot(scan_x, scan_y))
+               {
+                  dig_stack.push_back(index(scan_x, scan_y));
+               }
+            }
+         }
+      }
+   }
+
+   //! Dig a single plot, returns true if the plots around it should be dug too
+   bool digPlot(signed x, signed y)
+   {
+      Cell& cell = getCell(x, y);
+
+      if(!cell.plot.continueDig()) return false;
+
+      ++number_of_holes;
+
+      return cell.adjacent == 0;
+   }
+
+   void clearField()
+   {
+      for(auto& cell : field)
+      {
+         cell.plot.reset();
+         cell.adjacent = 0;
+      }
+   }
+
+   //! Plant all the mines avoiding the excluded plots
+   void plant(const uint64_t* excluded, unsigned number_excluded)
+   {
+      plantMines(random, field.size(), number_of_mines, excluded, number_excluded,
+                 [this](uint64_t index) { return field[index].plot.isMined(); },
+                 [this](uint64_t index)
+                 {
+                    field[index].plot.plantMine();
+                    addAdjacentMine(index % width, index / width);
+                 });
+   }
+
+   //! Re-plant, once, if there are any mines in the safe zone around the first dig
+   void clearSafeZone(unsigned x, unsigned y)
+   {
+      uint64_t zone[9];
+      unsigned n = getSafeZone(safe_zone, x, y, width, height, zone);
+
+      if((field.size() - n) < number_of_mines)
+      {
+         // Too many mines to keep the neighbourhood clear
+         n = getSafeZone(SAFE_PLOT, x, y, width, height, zone);
+      }
+
+      for(unsigned i = 0; i < n; ++i)
+      {
+         if(field[zone[i]].plot.isMined())
+         {
+            clearField();
+            plant(zone, n);
+            return;
+         }
+      }
+   }
+
+   //! Count a newly planted mine in the adjacent mine counts around it
+   void addAdjacentMine(signed x, signed y)
+   {
+      for(signed scan_y = y - 1; scan_y <= y + 1; ++scan_y)
+      {
+         for(signed scan_x = x - 1; scan_x <= x + 1; ++scan_x)
+         {
+            if(isValidPlot(scan_x, scan_y))
+            {
+               ++getCell(scan_x, scan_y).adjacent;
+            }
+         }
+      }
+   }
+
+   void showMines()
+   {
+      for(auto& cell : field)
+      {
+         cell.plot.reveal();
+      }
+   }
+
+   uint64_t index(signed x, signed y) const
+   {
+      assert(isValidPlot(x, y));
+
+      return uint64_t(y) * width + x;
+   }
+
+   Cell&       getCell(signed x, signed y)       { return field[index(x, y)]; }
+   const Cell& getCell(signed x, signed y) const { return field[index(x, y)]; }
+
+   unsigned width;
+   unsigned height;
+   Progress progress;
+   uint64_t number_of_mines;
+   uint64_t number_of_flags;
+   uint64_t number_of_holes;
+   uint32_t number_of_ticks;
+   SafeZone safe_zone{SAFE_PLOT};
+   Random   random;
+
+   std::vector<Cell>     field;
+   std::vector<uint64_t> dig_stack;
+};
+
+} // namespace MineSweeper
@@ -0,0 +1,551 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 John D. Haughton
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//------------------------------------------------------------------------------
+
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+#include "MineSweeperGame.h"
+#include "MineSweeperPlot.h"
+#include "MineSweeperStats.h"
+
+namespace MineSweeper {
+
+//! Mine sweeper game on a board with no bounds
+//
+//  Plots live in square chunks that are created on first touch. Whether a
+//  plot is mined is a hash of the seed, the chunk co-ordinates and the plot
+//  within the chunk, so the layout is never stored and adjacent mine counts
+//  work across chunk boundaries. Resident chunks are kept in least recently
+//  used order under a memory cap. When evicted, a chunk that was never
+//  touched is dropped, a fully resolved chunk is remembered by one bit in a
+//  bitmap of an 8x8 region of chunks and any other chunk is compacted to the
+//  plots that have been touched. The evicted state counts against the cap,
+//  so the resident chunks shrink to make room for it. Evicted state is part
+//  of the game and is never discarded, so once it alone exceeds the cap the
+//  memory used grows with the area explored, by a bit per resolved chunk and
+//  the touched plots of each partly resolved chunk
+class EndlessGame
+{
+public:
+   static const unsigned CHUNK_BITS  = 6;
+   static const unsigned CHUNK_SIZE  = 1 << CHUNK_BITS;
+   static const unsigned CHUNK_PLOTS = CHUNK_SIZE * CHUNK_SIZE;
+
+   //! Default memory cap for the board
+   static const size_t DEFAULT_MEMORY_CAP = 16 * 1024 * 1024;
+
+   //! Lowest density allowed, sparser fields can open regions without bound
+   static const unsigned MIN_DENSITY_PERCENT = 12;
+
+   //! Highest density allowed, the threshold must fit in 32 bits
+   static const unsigned MAX_DENSITY_PERCENT = 99;
+
+   //! A density outside MIN_DENSITY_PERCENT..MAX_DENSITY_PERCENT is clamped to that range
+   EndlessGame(unsigned density_percent_, uint64_t seed_ = 1,
+               size_t memory_cap_ = DEFAULT_MEMORY_CAP)
+      : density_percent(clampDensity(density_percent_))
+      , threshold(uint32_t((uint64_t(density_percent) << 32) / 100))
+      , memory_cap(memory_cap_)
+   {
+      reset(seed_);
+   }
+
+   //! Percentage of plots that are mines
+   unsigned getDensityPercent() const { return density_percent; }
+
+   //! Return current game state, an endless game is never cleared
+   Progress getProgress() const { return progress; }
+
+   //! Number of flags planted
+   uint64_t getNumberOfFlags() const { return number_of_flags; }
+
+   //! Number of holes dug
+   uint64_t getNumberOfHoles() const { return number_of_holes; }
+
+   //! State of plot at the given location
+   State getPlotState(int32_t x, int32_t y, bool& mine) const
+   {
+      mine = isMine(x, y);
+
+      uint64_t key  = getKey(x, y);
+      unsigned plot = getPlotIndex(x, y);
+
+      auto resident = index.find(key);
+      if(resident != index.end()) return resident->second->state[plot];
+
+      if(isResolved(key)) return mine ? UNDUG : HOLE;
+
+      auto compacted = compact.find(key);
+      if(compacted != compact.end()) return compacted->second.getState(plot);
+
+      return UNDUG;
+   }
+
+   //! Total number of mines in the 3x3 window centred on the given location, as in Game
+   unsigned getNumberOfAdjacentMines(int32_t x, int32_t y) const
+   {
+      unsigned n = isMine(x, y);
+
+      for(unsigned i = 0; i < NUM_NEIGHBOURS; ++i)
+      {
+         n += isMine(x + NEIGHBOUR_X[i], y + NEIGHBOUR_Y[i]);
+      }
+
+      return n;
+   }
+
+   //! Reset ready for new game with the layout generated from the given seed
+   void reset(uint64_t seed_)
+   {
+      seed = seed_;
+
+      lru.clear();
+      index.clear();
+      compact.clear();
+      resolved.clear();
+      last = nullptr;
+
+      compact_bytes   = 0;
+      resolved_chunks = 0;
+      number_of_flags = 0;
+      number_of_holes = 0;
+      evictions       = 0;
+      progress        = RESET;
+   }
+
+   //! Plant or unplant a flag in an undug plot
+   void plantUnplantFlag(int32_t x, int32_t y)
+   {
+      if(progress != CLEARING) return;
+
+      Chunk& chunk = getChunk(x, y);
+      State& state = chunk.state[getPlotIndex(x, y)];
+
+      if(state == UNDUG)
+      {
+         state = FLAG;
+         ++chunk.touched;
+         ++number_of_flags;
+      }
+      else if(state == FLAG)
+      {
+         state = UNDUG;
+         --chunk.touched;
+         --number_of_flags;
+      }
+   }
+
+   //! Dig a hole in an undug plot, the first dig is always safe
+   void digHole(int32_t x, int32_t y)
+   {
+      if(progress == DETONATED) return;
+
+      if(progress == RESET)
+      {
+         // Keep the plots around the first dig free of mines
+         safe_x   = x;
+         safe_y   = y;
+         progress = CLEARING;
+      }
+
+      Chunk& chunk = getChunk(x, y);
+      State& state = chunk.state[getPlotIndex(x, y)];
+
+      if(state != UNDUG) return;
+
+      Stats::add(Stats::DIGS);
+
+      if(isMine(x, y))
+      {
+         state = EXPLOSION;
+         ++chunk.touched;
+         progress = DETONATED;
+         return;
+      }
+
+      uint64_t before = number_of_holes;
+
+      floodFill(x, y);
+
+      Stats::add(Stats::CELLS_REVEALED, number_of_holes - before);
+   }
+
+   //! Number of chunks held in full
+   size_t getNumberOfResidentChunks() const { return index.size(); }
+
+   //! Number of evicted chunks held as touched plots
+   size_t getNumberOfCompactChunks() const { return compact.size(); }
+
+   //! Number of evicted chunks remembered as fully resolved
+   size_t getNumberOfResolvedChunks() const { return resolved_chunks; }
+
+   //! Number of chunks evicted so far
+   uint64_t getNumberOfEvictions() const { return evictions; }
+
+   //! Approximate heap memory in use for the board
+   size_t getMemoryBytes() const
+   {
+      return index.size() * RESIDENT_BYTES + getEvictedBytes()
+             + dig_stack.capacity() * sizeof(Location);
+   }
+
+   //! Approximate heap memory in use for evicted chunks
+   size_t getEvictedBytes() const
+   {
+      return compact.size() * (sizeof(Compact) + ENTRY_OVERHEAD) + compact_bytes
+             + resolved.size() * (sizeof(uint64_t) + ENTRY_OVERHEAD);
+   }
+
+private:
+   //! Resident chunks at least, so a flood fill can cross a corner
+   static const size_t MIN_RESIDENT = 8;
+
+   //! Rough cost of an entry in the hash containers and LRU list
+   static const size_t ENTRY_OVERHEAD = 48;
+
+   //! Touched plots above which a compacted chunk is stored at 2 bits per plot
+   static const unsigned SPARSE_LIMIT = CHUNK_PLOTS / 8;
+
+   //! Resolved chunks are grouped in square regions of this many chunks a side
+   static const unsigned REGION_BITS = 3;
+
+   static unsigned clampDensity(unsigned percent)
+   {
+      if(percent < MIN_DENSITY_PERCENT) return MIN_DENSITY_PERCENT;
+      if(percent > MAX_DENSITY_PERCENT) return MAX_DENSITY_PERCENT;
+      return percent;
+   }
+
+   struct Location
+   {
+      int32_t x;
+      int32_t y;
+   };
+
+   //! A resident chunk
+   struct Chunk
+   {
+      uint64_t                        key;
+      uint16_t                        safe;     //!< Plots free of mines
+      uint16_t                        holes;
+      uint16_t                        touched;  //!< Plots not UNDUG
+      std::array<State, CHUNK_PLOTS>  state;
+   };
+
+   //! Memory counted for each resident chunk
+   static const size_t RESIDENT_BYTES = sizeof(Chunk) + ENTRY_OVERHEAD;
+
+   //! An evicted chunk that still has state to remember
+   struct Compact
+   {
+      //! Touched plots as (plot << 2) | state when few, or 2 bits for every plot
+      std::vector<uint16_t> sparse;
+      std::vector<uint8_t>  packed;
+
+      State getState(unsigned plot) const
+      {
+         if(!packed.empty()) return State((packed[plot / 4] >> ((plot % 4) * 2)) & 3);
+
+         auto it = std::lower_bound(sparse.begin(), sparse.end(), uint16_t(plot << 2));
+         if((it != sparse.end()) && ((*it >> 2) == plot)) return State(*it & 3);
+
+         return UNDUG;
+      }
+
+      size_t getBytes() const { return sparse.capacity() * 2 + packed.capacity(); }
+   };
+
+   static int32_t getChunkCoord(int32_t v) { return v >> CHUNK_BITS; }
+
+   static uint64_t getKey(int32_t x, int32_t y)
+   {
+      return (uint64_t(uint32_t(getChunkCoord(x))) << 32) | uint32_t(getChunkCoord(y));
+   }
+
+   static unsigned getPlotIndex(int32_t x, int32_t y)
+   {
+      return ((y & (CHUNK_SIZE - 1)) << CHUNK_BITS) | (x & (CHUNK_SIZE - 1));
+   }
+
+   //! Key of the region holding a chunk
+   static uint64_t getRegionKey(uint64_t key)
+   {
+      int32_t cx = int32_t(uint32_t(key >> 32));
+      int32_t cy = int32_t(uint32_t(key));
+
+      return (uint64_t(uint32_t(cx >> REGION_BITS)) << 32) | uint32_t(cy >> REGION_BITS);
+   }
+
+   //! Bit for a chunk in the bitmap of its region
+   static uint64_t getRegionBit(uint64_t key)
+   {
+      const uint32_t mask = (1 << REGION_BITS) - 1;
+
+      return uint64_t(1) << (((uint32_t(key) & mask) << REGION_BITS) | (uint32_t(key >> 32) & mask));
+   }
+
+   bool isResolved(uint64_t key) const
+   {
+      auto it = resolved.find(getRegionKey(key));
+      return (it != resolved.end()) && ((it->second & getRegionBit(key)) != 0);
+   }
+
+   void markResolved(uint64_t key)
+   {
+      resolved[getRegionKey(key)] |= getRegionBit(key);
+      ++resolved_chunks;
+   }
+
+   //! Forget a chunk is resolved, returns false if it was not
+   bool takeResolved(uint64_t key)
+   {
+      auto it = resolved.find(getRegionKey(key));
+      if((it == resolved.end()) || ((it->second & getRegionBit(key)) == 0)) return false;
+
+      it->second &= ~getRegionBit(key);
+      if(it->second == 0) resolved.erase(it);
+
+      --resolved_chunks;
+      return true;
+   }
+
+   //! Number of resident chunks that fit in the cap alongside the evicted chunks
+   size_t getMaxResident() const
+   {
+      size_t evicted = getEvictedBytes();
+      size_t room    = memory_cap > evicted ? memory_cap - evicted : 0;
+
+      return std::max(size_t(MIN_RESIDENT), room / RESIDENT_BYTES);
+   }
+
+   //! splitmix64 finaliser
+   static uint64_t mix(uint64_t z)
+   {
+      z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9;
+      z = (z ^ (z >> 27)) * 0x94D049BB133111EB;
+      return z ^ (z >> 31);
+   }
+
+   //! Layout hash, a splitmix64 stream per chunk indexed by the plot
+   bool isMine(int32_t x, int32_t y) const
+   {
+      if((progress == RESET) ||
+         ((std::abs(int64_t(x) - safe_x) <= 1) && (std::abs(int64_t(y) - safe_y) <= 1)))
+      {
+         return false;
+      }
+
+      uint64_t chunk_seed = mix(seed ^ mix(getKey(x, y)));
+      uint64_t hash       = mix(chunk_seed + (getPlotIndex(x, y) + 1) * 0x9E3779B97F4A7C15);
+
+      return uint32_t(hash >> 32) < threshold;
+   }
+
+   //! Resident chunk for a location, materialised on first touch
+   Chunk& getChunk(int32_t x, int32_t y)
+   {
+      uint64_t key = getKey(x, y);
+
+      if((last != nullptr) && (last->key == key)) return *last;
+
+      auto it = index.find(key);
+      if(it != index.end())
+      {
+         lru.splice(lru.begin(), lru, it->second);
+         last = &lru.front();
+         return *last;
+      }
+
+      // Evicting can grow the evicted state and so shrink the room left
+      while(index.size() >= getMaxResident()) evict();
+
+      lru.emplace_front();
+      index[key] = lru.begin();
+
+      Chunk& chunk = lru.front();
+      materialise(chunk, key, x & ~int32_t(CHUNK_SIZE - 1), y & ~int32_t(CHUNK_SIZE - 1));
+
+      last = &chunk;
+      return chunk;
+   }
+
+   //! Fill in a new resident chunk from its evicted form, if any
+   void materialise(Chunk& chunk, uint64_t key, int32_t x0, int32_t y0)
+   {
+      chunk.key     = key;
+      chunk.safe    = 0;
+      chunk.holes   = 0;
+      chunk.touched = 0;
+
+      for(unsigned plot = 0; plot < CHUNK_PLOTS; ++plot)
+      {
+         chunk.safe += !isMine(x0 + int32_t(plot % CHUNK_SIZE), y0 + int32_t(plot / CHUNK_SIZE));
+      }
+
+      chunk.state.fill(UNDUG);
+
+      if(takeResolved(key))
+      {
+         for(unsigned plot = 0; plot < CHUNK_PLOTS; ++plot)
+         {
+            if(!isMine(x0 + int32_t(plot % CHUNK_SIZE), y0 + int32_t(plot / CHUNK_SIZE)))
+            {
+               chunk.state[plot] = HOLE;
+            }
+         }
+
+         chunk.holes   = chunk.safe;
+         chunk.touched = chunk.safe;
+         return;
+      }
+
+      auto it = compact.find(key);
+      if(it == compact.end()) return;
+
+      for(unsigned plot = 0; plot < CHUNK_PLOTS; ++plot)
+      {
+         State state = it->second.getState(plot);
+
+         chunk.state[plot] = state;
+         chunk.holes      += state == HOLE;
+         chunk.touched    += state != UNDUG;
+      }
+
+      compact_bytes -= it->second.getBytes();
+      compact.erase(it);
+   }
+
+   //! Evict the least recently used resident chunk
+   void evict()
+   {
+      Chunk& chunk = lru.back();
+
+      ++evictions;
+
+      if(chunk.touched == 0)
+      {
+         // Nothing to remember
+      }
+      else if((chunk.holes == chunk.safe) && (chunk.touched == chunk.holes))
+      {
+         markResolved(chunk.key);
+      }
+      else
+      {
+         Compact& stored = compact[chunk.key];
+
+         if(chunk.touched <= SPARSE_LIMIT)
+         {
+            stored.sparse.reserve(chunk.touched);
+
+            for(unsigned plot = 0; plot < CHUNK_PLOTS; ++plot)
+            {
+               if(chunk.state[plot] != UNDUG)
+               {
+                  stored.sparse.push_back(uint16_t((plot << 2) | chunk.state[plot]));
+               }
+            }
+         }
+         else
+         {
+            stored.packed.assign(CHUNK_PLOTS / 4, 0);
+
+            for(unsigned plot = 0; plot < CHUNK_PLOTS; ++plot)
+            {
+               stored.packed[plot / 4] |= chunk.state[plot] << ((plot % 4) * 2);
+            }
+         }
+
+         compact_bytes += stored.getBytes();
+      }
+
+      if(last == &chunk) last = nullptr;
+
+      index.erase(chunk.key);
+      lru.pop_back();
+   }
+
+   //! Dig the given plot and the region opened up around it
+   void floodFill(int32_t x, int32_t y)
+   {
+      dig_stack.clear();
+      dig_stack.push_back({x, y});
+
+      while(!dig_stack.empty())
+      {
+         Location at = dig_stack.back();
+         dig_stack.pop_back();
+
+         Chunk& chunk = getChunk(at.x, at.y);
+         State& state = chunk.state[getPlotIndex(at.x, at.y)];
+
+         if(state != UNDUG) continue;
+
+         state = HOLE;
+         ++chunk.holes;
+         ++chunk.touched;
+         ++number_of_holes;
+
+         if(getNumberOfAdjacentMines(at.x, at.y) != 0) continue;
+
+         for(unsigned i = 0; i < NUM_NEIGHBOURS; ++i)
+         {
+            dig_stack.push_back({at.x + NEIGHBOUR_X[i], at.y + NEIGHBOUR_Y[i]});
+         }
+      }
+   }
+
+   unsigned density_percent;
+   uint32_t threshold;
+   size_t   memory_cap;
+   uint64_t seed{1};
+   Progress progress{RESET};
+   int32_t  safe_x{0};
+   int32_t  safe_y{0};
+   uint64_t number_of_flags{0};
+   uint64_t number_of_holes{0};
+   uint64_t evictions{0};
+
+   //! Resident chunks, most recently used first
+   std::list<Chunk>                                           lru;
+   std::unordered_map<uint64_t, std::list<Chunk>::iterator>   index;
+   Chunk*                                                     last{nullptr};
+
+   //! Evicted chunks, resolved chunks as a bitmap per region
+   std::unordered_map<uint64_t, Compact>                      compact;
+   std::unordered_map<uint64_t, uint64_t>                     resolved;
+   size_t                                                     compact_bytes{0};
+   size_t                                                     resolved_chunks{0};
+
+   //! Work stack for floodFill(), plots still to be expanded
+   std::vector<Location>                                      dig_stack;
+};
+
+} // namespace MineSweeper
@@ -0,0 +1,181 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 John D. Haughton
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//------------------------------------------------------------------------------
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+#include "MineSweeperGame.h"
+
+namespace MineSweeper {
+
+//! A game at one of the standard levels behind a single non-template class
+//
+//  Backs the flat C API of the engine-only WebAssembly module. Moves off the
+//  board are ignored rather than asserted as they arrive from script
+class Engine
+{
+public:
+   static const unsigned NUM_LEVELS = 3;
+
+   static bool isValidLevel(unsigned level) { return (level >= 1) && (level <= NUM_LEVELS); }
+
+   Engine(unsigned level_, uint64_t seed = 1)
+      : level(level_)
+   {
+      assert(isValidLevel(level));
+
+      switch(level)
+      {
+      case 1: game = new Game<9, 9>(10, seed);   break;
+      case 2: game = new Game<16, 16>(40, seed); break;
+      case 3: game = new Game<30, 16>(99, seed); break;
+      }
+   }
+
+   ~Engine()
+   {
+      visit([](auto& game){ delete &game; });
+   }
+
+   Engine(const Engine&) = delete;
+   Engine& operator=(const Engine&) = delete;
+
+   //! Width of the board
+   unsigned getWidth() const { return getInfo().width; }
+
+   //! Height of the board
+   unsigned getHeight() const { return getInfo().height; }
+
+   //! Number of plots, and the size of buffer needed by readBoard()
+   unsigned getNumberOfPlots() const { return getWidth() * getHeight(); }
+
+   //! Return current game state
+   Progress getProgress() const
+   {
+      Progress progress = RESET;
+      visit([&](const auto& game){ progress = game.getProgress(); });
+      return progress;
+   }
+
+   //! Number of available flags
+   unsigned getNumberOfFlags() const
+   {
+      unsigned flags = 0;
+      visit([&](const auto& game){ flags = game.getNumberOfFlags(); });
+      return flags;
+   }
+
+   //! Reset ready for new game with the layout generated from the given seed
+   void reset(uint64_t seed)
+   {
+      visit([&](auto& game){ game.reset(seed); });
+   }
+
+   //! Dig a hole, returns the resulting game state
+   Progress digHole(unsigned x, unsigned y)
+   {
+      if(isOnBoard(x, y))
+      {
+         visit([&](auto& game){ game.digHole(x, y); });
+      }
+
+      return getProgress();
+   }
+
+   //! Plant or unplant a flag, returns the resulting game state
+   Progress plantUnplantFlag(unsigned x, unsigned y)
+   {
+      if(isOnBoard(x, y))
+      {
+         visit([&](auto& game){ game.plantUnplantFlag(x, y); });
+      }
+
+      return getProgress();
+   }
+
+   //! Copy the visible code of every plot, one byte each in row order
+   //
+   //  Returns the number of bytes written, zero if the buffer is too small
+   size_t readBoard(uint8_t* buffer, size_t size) const
+   {
+      if(size < getNumberOfPlots()) return 0;
+
+      visit([&](const auto& game)
+      {
+         uint8_t* out = buffer;
+
+         for(unsigned y = 0; y < game.getHeight(); ++y)
+         {
+            for(unsigned x = 0; x < game.getWidth(); ++x)
+            {
+               *out++ = game.getVisibleCode(x, y);
+            }
+         }
+      });
+
+      return getNumberOfPlots();
+   }
+
+private:
+   struct Info
+   {
+      uint8_t width;
+      uint8_t height;
+   };
+
+   const Info& getInfo() const
+   {
+      static const Info table[NUM_LEVELS + 1] = {{0, 0}, {9, 9}, {16, 16}, {30, 16}};
+      return table[level];
+   }
+
+   bool isOnBoard(unsigned x, unsigned y) const
+   {
+      return (x < getWidth()) && (y < getHeight());
+   }
+
+   //! Call fn with the game as its real type
+   template <typename FN>
+   void visit(FN fn)
+   {
+      switch(level)
+      {
+      case 1: fn(*static_cast<Game<9, 9>*>(game));   break;
+      case 2: fn(*static_cast<Game<16, 16>*>(game)); break;
+      case 3: fn(*static_cast<Game<30, 16>*>(game)); break;
+      }
+   }
+
+   template <typename FN>
+   void visit(FN fn) const
+   {
+      const_cast<Engine*>(this)->visit([&](const auto& game){ fn(game); });
+   }
+
+   unsigned level;
+   void*    game{nullptr};
+};
+
+} // namespace MineSweeper
@@ -0,0 +1,247 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 John D. Haughton
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//------------------------------------------------------------------------------
+
+
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "MineSweeperAdjacency.h"
+#include "MineSweeperBitBoard.h"
+#include "MineSweeperGame.h"
+#include "MineSweeperPlot.h"
+
+namespace MineSweeper {
+
+//! Mine layout and adjacent mine counts, fixed once the first hole is dug
+template <unsigned WIDTH, unsigned HEIGHT>
+struct Minefield
+{
+   BitBoard<WIDTH, HEIGHT>             mines;
+   std::array<uint8_t, WIDTH * HEIGHT> adjacent;
+   Counter<WIDTH * HEIGHT>             number_of_mines;
+};
+
+//! Cheap copy of a game in progress for search-based players
+//
+//  The layout is held in an immutable Minefield shared by every copy so
+//  copying a GameFork only duplicates the visible state of each plot and
+//  the counters. A fork plays exactly like the game it was taken from and
+//  has the same interface as the other game engines. Forks are taken
+//  after the first dig, once the layout can no longer be re-planted
+template <unsigned WIDTH, unsigned HEIGHT>
+class GameFork
+{
+public:
+   template <typename GAME>
+   explicit GameFork(const GAME& game)
+      : number_of_flags(game.getNumberOfFlags())
+      , number_of_ticks(game.getNumberOfTicks())
+      , progress(game.getProgress())
+   {
+      assert(progress != RESET);
+
+      auto field = std::make_shared<Minefield<WIDTH, HEIGHT>>();
+
+      field->mines.clearAll();
+      field->number_of_mines = 0;
+
+      for(unsigned y = 0; y < HEIGHT; ++y)
+      {
+         for(unsigned x = 0; x < WIDTH; ++x)
+         {
+            unsigned index = y * WIDTH + x;
+            bool     mine;
+
+            state[index] = game.getPlotState(x, y, mine);
+
+            if(mine)
+            {
+               field->mines.set(x, y);
+               ++field->number_of_mines;
+            }
+            else if(state[index] == HOLE)
+            {
+               ++number_of_holes;
+            }
+         }
+      }
+
+      countAdjacent(field->mines, field->adjacent.data());
+
+      minefield = field;
+   }
+
+   //! Width of the board
+   static unsigned getWidth() { return WIDTH; }
+
+   //! Height of the board
+   static unsigned getHeight() { return HEIGHT; }
+
+   //! Return current game state
+   Progress getProgress() const { return progress; }
+
+   //! Number of available flags
+   unsigned getNumberOfFlags() const { return number_of_flags; }
+
+   //! Number of ticks that the game has been underway
+   unsigned getNumberOfTicks() const { return number_of_ticks; }
+
+   //! State of plot at the given location
+   State getPlotState(unsigned x, unsigned y, bool& mine) const
+   {
+      mine = minefield->mines.test(x, y);
+      return state[y * WIDTH + x];
+   }
+
+   //! Total number of mines adjacent to the given location
+   unsigned getNumberOfAdjacentMines(signed x, signed y) const
+   {
+      return minefield->adjacent[y * WIDTH + x];
+   }
+
+   //! Plant or unplant a flag in an undug plot
+   void plantUnplantFlag(unsigned x, unsigned y)
+   {
+      if(progress != CLEARING) return;
+
+      State& plot = state[y * WIDTH + x];
+
+      if((plot == UNDUG) && (number_of_flags > 0))
+      {
+         plot = FLAG;
+         --number_of_flags;
+         checkIfCleared();
+      }
+      else if(plot == FLAG)
+      {
+         plot = UNDUG;
+         ++number_of_flags;
+      }
+   }
+
+   //! Dig a hole in an undug plot
+   void digHole(unsigned x, unsigned y)
+   {
+      if((progress != CLEARING) || (state[y * WIDTH + x] != UNDUG)) return;
+
+      if(minefield->mines.test(x, y))
+      {
+         state[y * WIDTH + x] = EXPLOSION;
+         showMines();
+         progress = DETONATED;
+      }
+      else
+      {
+         tryDig(x, y);
+         checkIfCleared();
+      }
+   }
+
+   //! Increment game timer
+   void tick()
+   {
+      if(progress == CLEARING)
+      {
+         ++number_of_ticks;
+      }
+   }
+
+private:
+   void checkIfCleared()
+   {
+      if((number_of_holes + minefield->number_of_mines - number_of_flags) == (WIDTH * HEIGHT))
+      {
+         progress = CLEARED;
+      }
+   }
+
+   //! Dig the given plot and, if it has no adjacent mines, the region around it
+   void tryDig(signed x, signed y)
+   {
+      if(!digPlot(y * WIDTH + x)) return;
+
+      // Shared by all forks on a thread so that copies need no allocation
+      static thread_local std::vector<uint32_t> dig_stack;
+
+      dig_stack.clear();
+      dig_stack.push_back(y * WIDTH + x);
+
+      while(!dig_stack.empty())
+      {
+         unsigned index = dig_stack.back();
+         dig_stack.pop_back();
+
+         signed plot_x = index % WIDTH;
+         signed plot_y = index / WIDTH;
+
+         for(signed scan_y = plot_y - 1; scan_y <= plot_y + 1; ++scan_y)
+         {
+            if((scan_y < 0) || (scan_y >= signed(HEIGHT))) continue;
+
+            for(signed scan_x = plot_x - 1; scan_x <= plot_x + 1; ++scan_x)
+            {
+               if((scan_x < 0) || (scan_x >= signed(WIDTH))) continue;
+
+               unsigned scan_index = scan_y * WIDTH + scan_x;
+
+               if(digPlot(scan_index)) dig_stack.push_back(scan_index);
+            }
+         }
+      }
+   }
+
+   //! Dig a single plot, returns true if the plots around it should be dug too
+   bool digPlot(unsigned index)
+   {
+      if((state[index] != UNDUG) || minefield->mines.test(index % WIDTH, index / WIDTH)) return false;
+
+      state[index] = HOLE;
+      ++number_of_holes;
+
+      return minefield->adjacent[index] == 0;
+   }
+
+   void showMines()
+   {
+      minefield->mines.forEach([this](unsigned x, unsigned y)
+      {
+         State& plot = state[y * WIDTH + x];
+         if(plot != EXPLOSION) plot = HOLE;
+      });
+   }
+
+   using Count = Counter<WIDTH * HEIGHT>;
+
+   std::shared_ptr<const Minefield<WIDTH, HEIGHT>> minefield;
+   std::array<State, WIDTH * HEIGHT>               state;
+   Count                                           number_of_flags;
+   Count                                           number_of_holes{0};
+   uint32_t                                        number_of_ticks;
+   Progress                                        progress;
+};
+
+} // namespace MineSweeper
@@ -0,0 +1,511 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 John D. Haughton
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//------------------------------------------------------------------------------
+
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "MineSweeperBatch.h"
+#include "MineSweeperDynamicGame.h"
+#include "MineSweeperGame.h"
+#include "MineSweeperPackedGame.h"
+#include "MineSweeperRandom.h"
+
+namespace MineSweeper {
+
+//! Differential testing of the alternative engines against the reference Game
+//
+//  A case is a seed, safe zone, mine count and move sequence. The reference
+//  and an engine under test play the case side by side and every plot,
+//  the flags and the progress are compared after each move. A failing case
+//  is shrunk to a minimal move sequence that still shows a difference
+namespace Fuzz {
+
+//! One differential test case
+struct Case
+{
+   uint64_t          seed{1};
+   SafeZone          zone{SAFE_PLOT};
+   unsigned          mines{1};
+   std::vector<Move> moves;
+};
+
+//! Any engine with the Game API, moves applied one call at a time
+template <typename GAME>
+class Subject
+{
+public:
+   template <typename... ARGS>
+   Subject(SafeZone zone, ARGS... args)
+      : game(args...)
+   {
+      game.setSafeZone(zone);
+   }
+
+   void apply(const Move& move)
+   {
+      if(move.type == Move::DIG)
+         game.digHole(move.x, move.y);
+      else
+         game.plantUnplantFlag(move.x, move.y);
+   }
+
+   Progress getProgress() const { return game.getProgress(); }
+
+   unsigned getNumberOfFlags() const { return unsigned(game.getNumberOfFlags()); }
+
+   State getPlotState(unsigned x, unsigned y, bool& mine) const
+   {
+      return game.getPlotState(x, y, mine);
+   }
+
+   unsigned getNumberOfAdjacentMines(unsigned x, unsigned y) const
+   {
+      return game.getNumberOfAdjacentMines(x, y);
+   }
+
+protected:
+   GAME game;
+};
+
+template <unsigned WIDTH, unsigned HEIGHT>
+class PackedSubject : public Subject<PackedGame<WIDTH, HEIGHT>>
+{
+public:
+   static const char* getName() { return "PackedGame"; }
+
+   PackedSubject(const Case& c)
+      : Subject<PackedGame<WIDTH, HEIGHT>>(c.zone, c.mines, c.seed)
+   {
+   }
+};
+
+template <unsigned WIDTH, unsigned HEIGHT>
+class DynamicSubject : public Subject<DynamicGame>
+{
+public:
+   static const char* getName() { return "DynamicGame"; }
+
+   DynamicSubject(const Case& c)
+      : Subject<DynamicGame>(c.zone, WIDTH, HEIGHT, c.mines, c.seed)
+   {
+   }
+};
+
+//! The reference Game itself but driven through applyMoves()
+template <unsigned WIDTH, unsigned HEIGHT>
+class MovesSubject : public Subject<Game<WIDTH, HEIGHT>>
+{
+public:
+   static const char* getName() { return "Game::applyMoves"; }
+
+   MovesSubject(const Case& c)
+      : Subject<Game<WIDTH, HEIGHT>>(c.zone, c.mines, c.seed)
+   {
+   }
+
+   void apply(const Move& move)
+   {
+      this->game.applyMoves(&move, 1);
+   }
+};
+
+//! The first game of a GameBatch
+template <unsigned WIDTH, unsigned HEIGHT>
+class BatchSubject
+{
+public:
+   static const char* getName() { return "GameBatch"; }
+
+   BatchSubject(const Case& c)
+      : batch(1, c.mines, c.seed, c.zone)
+   {
+   }
+
+   void apply(const Move& move)
+   {
+      if(move.type == Move::DIG)
+      {
+         uint16_t plot = uint16_t(move.y * WIDTH + move.x);
+         batch.digHoles(&plot);
+      }
+      else
+      {
+         batch.plantUnplantFlag(0, move.x, move.y);
+      }
+   }
+
+   Progress getProgress() const { return batch.getProgress(0); }
+
+   unsigned getNumberOfFlags() const { return batch.getNumberOfFlags(0); }
+
+   State getPlotState(unsigned x, unsigned y, bool& mine) const
+   {
+      return batch.getPlotState(0, x, y, mine);
+   }
+
+   unsigned getNumberOfAdjacentMines(unsigned x, unsigned y) const
+   {
+      return batch.getNumberOfAdjacentMines(0, x, y);
+   }
+
+private:
+   GameBatch<WIDTH, HEIGHT> batch;
+};
+
+//! Compare a subject with the reference, describing the first difference
+template <unsigned WIDTH, unsigned HEIGHT, typename SUBJECT>
+bool isSame(const Game<WIDTH, HEIGHT>& ref, const SUBJECT& subject, std::string* what = nullptr)
+{
+   char text[128];
+
+   if(ref.getProgress() != subject.getProgress())
+   {
+      snprintf(text, sizeof(text), "progress %u != %u",
+               unsigned(subject.getProgress()), unsigned(ref.getProgress()));
+   }
+   else if(ref.getNumberOfFlags() != subject.getNumberOfFlags())
+   {
+      snprintf(text, sizeof(text), "flags %u != %u",
+               subject.getNumberOfFlags(), ref.getNumberOfFlags());
+   }
+   else
+   {
+      for(unsigned y = 0; y < HEIGHT; ++y)
+      {
+         for(unsigned x = 0; x < WIDTH; ++x)
+         {
+            bool  ref_mine, mine;
+            State ref_state = ref.getPlotState(x, y, ref_mine);
+            State state     = subject.getPlotState(x, y, mine);
+
+            if((state != ref_state) || (mine != ref_mine))
+            {
+               snprintf(text, sizeof(text), "plot (%u,%u) state %u mine %u != state %u mine %u",
+                        x, y, unsigned(state), unsigned(mine), unsigned(ref_state), unsigned(ref_mine));
+            }
+            else if(subject.getNumberOfAdjacentMines(x, y) != ref.getNumberOfAdjacentMines(x, y))
+            {
+               snprintf(text, sizeof(text), "plot (%u,%u) adjacent %u != %u", x, y,
+                        subject.getNumberOfAdjacentMines(x, y), ref.getNumberOfAdjacentMines(x, y));
+            }
+            else
+            {
+               continue;
+            }
+
+            if(what != nullptr) *what = text;
+            return false;
+         }
+      }
+
+      return true;
+   }
+
+   if(what != nullptr) *what = text;
+   return false;
+}
+
+//! No difference found
+static const size_t NO_FAILURE = size_t(-1);
+
+//! Play a case on the reference and a subject
+//
+//  Returns the number of moves applied when the first difference was seen,
+//  zero for a difference before any move, or NO_FAILURE
+template <template <unsigned, unsigned> class SUBJECT, unsigned WIDTH, unsigned HEIGHT>
+size_t findFailure(const Case& c, std::string* what = nullptr)
+{
+   Game<WIDTH, HEIGHT>     ref{c.mines, c.seed};
+   SUBJECT<WIDTH, HEIGHT>  subject{c};
+
+   ref.setSafeZone(c.zone);
+
+   if(!isSame(ref, subject, what)) return 0;
+
+   for(size_t i = 0; i < c.moves.size(); ++i)
+   {
+      const Move& move = c.moves[i];
+
+      if(move.type == Move::DIG)
+         ref.digHole(move.x, move.y);
+      else
+         ref.plantUnplantFlag(move.x, move.y);
+
+      subject.apply(move);
+
+      if(!isSame(ref, subject, what)) return i + 1;
+   }
+
+   return NO_FAILURE;
+}
+
+//! Shrink a failing case to a move sequence where no single move can be removed
+template <template <unsigned, unsigned> class SUBJECT, unsigned WIDTH, unsigned HEIGHT>
+Case shrink(Case failing)
+{
+   size_t failed_at = findFailure<SUBJECT, WIDTH, HEIGHT>(failing);
+   assert(failed_at != NO_FAILURE);
+
+   // Moves after the first difference are not needed
+   failing.moves.resize(failed_at);
+
+   // Remove runs of moves, halving the run length each pass. Dropping a
+   // move can make an earlier one removable, so single moves are retried
+   // until a pass removes nothing
+   for(size_t run = std::max(size_t(1), failing.moves.size() / 2); run >= 1; )
+   {
+      bool removed = false;
+
+      for(size_t at = 0; at + run <= failing.moves.size(); )
+      {
+         Case trial = failing;
+         trial.moves.erase(trial.moves.begin() + at, trial.moves.begin() + at + run);
+
+         failed_at = findFailure<SUBJECT, WIDTH, HEIGHT>(trial);
+
+         if(failed_at != NO_FAILURE)
+         {
+            trial.moves.resize(failed_at);
+            failing = trial;
+            removed = true;
+         }
+         else
+         {
+            at += run;
+         }
+      }
+
+      if((run > 1) || !removed) run /= 2;
+   }
+
+   return failing;
+}
+
+//! Generate a case, playing the reference so that most moves are informed
+//
+//  A quarter of the moves are at random plots and the rest dig a safe plot
+//  or flag a mine, so that games last long enough to reach the end game
+template <unsigned WIDTH, unsigned HEIGHT>
+Case makeCase(Random& random)
+{
+   Case c;
+
+   c.seed  = random();
+   c.zone  = random.below(2) ? SAFE_NEIGHBOURHOOD : SAFE_PLOT;
+   c.mines = 1 + unsigned(random.below(WIDTH * HEIGHT / 3));
+
+   Game<WIDTH, HEIGHT> ref{c.mines, c.seed};
+   ref.setSafeZone(c.zone);
+
+   size_t length = 1 + random.below(2 * WIDTH * HEIGHT);
+
+   for(size_t i = 0; (i < length) && (ref.getProgress() <= CLEARING); ++i)
+   {
+      Move move{uint16_t(random.below(WIDTH)), uint16_t(random.below(HEIGHT)),
+                random.below(5) == 0 ? Move::FLAG : Move::DIG};
+
+      if((ref.getProgress() == CLEARING) && (random.below(4) != 0))
+      {
+         // Informed move, look for an undug plot a few times
+         for(unsigned attempt = 0; attempt < 8; ++attempt)
+         {
+            bool mine;
+            if(ref.getPlotState(move.x, move.y, mine) == UNDUG)
+            {
+               move.type = mine ? Move::FLAG : Move::DIG;
+               break;
+            }
+
+            move.x = uint16_t(random.below(WIDTH));
+            move.y = uint16_t(random.below(HEIGHT));
+         }
+      }
+
+      if(move.type == Move::DIG)
+         ref.digHole(move.x, move.y);
+      else
+         ref.plantUnplantFlag(move.x, move.y);
+
+      c.moves.push_back(move);
+   }
+
+   return c;
+}
+
+//! Format a case as a reproducer
+inline std::string format(const Case& c)
+{
+   std::string text;
+   char        buffer[64];
+
+   snprintf(buffer, sizeof(buffer), "seed %llu zone %u mines %u moves %zu\n",
+            (unsigned long long)c.seed, unsigned(c.zone), c.mines, c.moves.size());
+   text += buffer;
+
+   for(const Move& move : c.moves)
+   {
+      snprintf(buffer, sizeof(buffer), "   %s %u %u\n",
+               move.type == Move::DIG ? "DIG " : "FLAG", move.x, move.y);
+      text += buffer;
+   }
+
+   return text;
+}
+
+//! Totals from a fuzzing run
+struct Result
+{
+   uint64_t    cases{0};
+   uint64_t    moves{0};
+   double      seconds{0.0};
+   bool        failed{false};
+   std::string report;  //!< Shrunk reproducer of the first failure
+
+   double getMovesPerSecond() const { return seconds > 0.0 ? moves / seconds : 0.0; }
+};
+
+//! Fuzz every engine on several board sizes across worker threads
+class Runner
+{
+public:
+   Runner(unsigned number_of_threads_ = 0)
+      : number_of_threads(number_of_threads_)
+   {
+      if(number_of_threads == 0)
+      {
+         number_of_threads = std::max(1u, std::thread::hardware_concurrency());
+      }
+   }
+
+   //! Number of worker threads used
+   unsigned getNumberOfThreads() const { return number_of_threads; }
+
+   //! Run until the time is up or a difference is found
+   Result run(double seconds, uint64_t seed)
+   {
+      using Clock = std::chrono::steady_clock;
+
+      auto start    = Clock::now();
+      auto deadline = start + std::chrono::duration_cast<Clock::duration>(
+                                 std::chrono::duration<double>(seconds));
+
+      std::vector<std::thread> workers;
+      std::atomic<bool>        stop{false};
+
+      Result result;
+
+      for(unsigned i = 0; i < number_of_threads; ++i)
+      {
+         workers.emplace_back([&, i]
+         {
+            Random   random{seed + i};
+            uint64_t cases = 0;
+            uint64_t moves = 0;
+
+            while(!stop.load(std::memory_order_relaxed) && (Clock::now() < deadline))
+            {
+               if(!fuzzBoards(random, cases, moves, result))
+               {
+                  stop = true;
+               }
+            }
+
+            std::lock_guard<std::mutex> lock{mutex};
+            result.cases += cases;
+            result.moves += moves;
+         });
+      }
+
+      for(auto& worker : workers) worker.join();
+
+      result.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+      return result;
+   }
+
+private:
+   //! One case on each board size, false on a failure
+   bool fuzzBoards(Random& random, uint64_t& cases, uint64_t& moves, Result& result)
+   {
+      return fuzzBoard<9, 9>(random, cases, moves, result) &&
+             fuzzBoard<16, 16>(random, cases, moves, result) &&
+             fuzzBoard<30, 16>(random, cases, moves, result) &&
+             fuzzBoard<8, 3>(random, cases, moves, result);
+   }
+
+   //! One case played against every engine, false on a failure
+   template <unsigned WIDTH, unsigned HEIGHT>
+   bool fuzzBoard(Random& random, uint64_t& cases, uint64_t& moves, Result& result)
+   {
+      Case c = makeCase<WIDTH, HEIGHT>(random);
+
+      return fuzzEngine<PackedSubject, WIDTH, HEIGHT>(c, cases, moves, result) &&
+             fuzzEngine<DynamicSubject, WIDTH, HEIGHT>(c, cases, moves, result) &&
+             fuzzEngine<BatchSubject, WIDTH, HEIGHT>(c, cases, moves, result) &&
+             fuzzEngine<MovesSubject, WIDTH, HEIGHT>(c, cases, moves, result);
+   }
+
+   template <template <unsigned, unsigned> class SUBJECT, unsigned WIDTH, unsigned HEIGHT>
+   bool fuzzEngine(const Case& c, uint64_t& cases, uint64_t& moves, Result& result)
+   {
+      ++cases;
+      moves += c.moves.size();
+
+      if(findFailure<SUBJECT, WIDTH, HEIGHT>(c) == NO_FAILURE) return true;
+
+      Case        minimal = shrink<SUBJECT, WIDTH, HEIGHT>(c);
+      std::string what;
+      findFailure<SUBJECT, WIDTH, HEIGHT>(minimal, &what);
+
+      char header[128];
+      snprintf(header, sizeof(header), "%s %ux%u differs from Game: %s\n",
+               SUBJECT<WIDTH, HEIGHT>::getName(), WIDTH, HEIGHT, what.c_str());
+
+      std::lock_guard<std::mutex> lock{mutex};
+
+      if(!result.failed)
+      {
+         result.failed = true;
+         result.report = header + format(minimal);
+      }
+
+      return false;
+   }
+
+   unsigned   number_of_threads;
+   std::mutex mutex;
+};
+
+} // namespace Fuzz
+
+} // namespace MineSweeper
@@ -22,29 +22,34 @@
 
 #pragma once
 
-#include <cassert>
-
 #include "GUI/Font/Teletext.h"
 #include "GUI/GUI.h"
 
 #include "LEDDisplay.h"
 #include "MineSweeperGame.h"
+#include "MinefieldWidget.h"
+#include "MineSweeperStats.h"
 
 
-// 2 char "Mine" and "Flag" font
-static const uint8_t font_mines_data[] =
+//! Test hook for the tests and benchmarks, which drive a GUI without an event loop
+struct MineSweeperGUITestHook
 {
-   0x08, 0x00, 0x88, 0x80, 0x5D, 0x00, 0x3E, 0x00, 0x67, 0x00, 0xEF, 0xC0, 0x7F, 0x00, 0x3E, 0x00,
-   0x5D, 0x00, 0x88, 0x80, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-   0x02, 0x00, 0x0E, 0x00, 0x3E, 0x00, 0x7E, 0x00, 0x3E, 0x00, 0x0E, 0x00, 0x02, 0x00, 0x02, 0x00,
-   0x02, 0x00, 0x07, 0x00, 0x3F, 0xC0, 0x3F, 0xC0, 0x00, 0x00, 0x00, 0x00
+   template <typename GUI_TYPE>
+   static void refresh(GUI_TYPE& gui) { gui.refresh(); }
+
+   template <typename GUI_TYPE>
+   static auto& getGame(GUI_TYPE& gui) { return gui.game; }
+
+   template <typename GUI_TYPE>
+   static auto& getField(GUI_TYPE& gui) { return gui.gui_field; }
 };
-static const GUI::Font font_mines = {{10, 15}, 0x30, 0x31, 1, font_mines_data};
 
 
 template <unsigned GAME_COLS, unsigned GAME_ROWS>
 class MineSweeperGUI : public GUI::App
 {
+   friend struct MineSweeperGUITestHook;
+
 public:
    MineSweeperGUI(unsigned num_mines)
       : GUI::App("Mine Sweeper", &GUI::font_teletext15)
@@ -53,27 +58,27 @@ public:
       gui_top.setAlign(GUI::Align::CENTER, GUI::Align::CENTER);
 
       gui_help.setFlat();
+      gui_undo.setFlat();
+      gui_redo.setFlat();
 
-      // Construct the minefield
-      for(unsigned y = 0; y < GAME_ROWS; ++y)
-      {
-         gui_btm.pushBack(&gui_row[y]);
+      game.enableHistory(HISTORY_BYTES);
 
-         for(unsigned x = 0; x < GAME_COLS; ++x)
-         {
-            unsigned code = (y << EV_Y_LSB) | (x << EV_X_LSB);
-
-            GUI::TextButton* b = &gui_btn[x][y];
-
-            gui_row[y].pushBack(b);
+      // Scroll and zoom controls only when the board does not fit
+      if(gui_field.isScrollable())
+      {
+         addMenuButton(gui_zoom_out, EV_ZOOM_OUT, "-");
+         addMenuButton(gui_zoom_in,  EV_ZOOM_IN,  "+");
+         addMenuButton(gui_left,     EV_LEFT,     "<");
+         addMenuButton(gui_right,    EV_RIGHT,    ">");
+         addMenuButton(gui_up,       EV_UP,       "^");
+         addMenuButton(gui_down,     EV_DOWN,     "v");
+      }
 
-            b->setCode(EV_DIG | code);
-            b->setBorderAndGap(4);
-            b->setAltCode(false, EV_FLAG | code);
-            b->text.setText(" ");
-            b->text.setCols(2);
-            b->text.setAlign(GUI::Align::CENTER);
-         }
+      // Room in the flag counter for large numbers of mines
+      unsigned digits = snprintf(nullptr, 0, "%u", num_mines);
+      if(digits > 3)
+      {
+         gui_flags.setCols(digits);
       }
 
       // Sync GUI state with initial game state
@@ -90,18 +95,37 @@ private:
    //! Handle events from the GUI
    void appEvent(Widget*, unsigned code) override
    {
+      MineSweeper::Stats::ScopedTimer timer{MineSweeper::Stats::APP_EVENT};
+
       if(code == EV_RESET)
       {
          game.reset();
       }
+      else if(code == EV_UNDO)
+      {
+         game.undo();
+      }
+      else if(code == EV_REDO)
+      {
+         game.redo();
+      }
+      else if((code >= EV_ZOOM_IN) && (code <= EV_DOWN))
+      {
+         // Only the view can change
+         moveView(code);
+         return;
+      }
       else if(code == EV_TICK)
       {
+         // Only the clock can change
          game.tick();
+         refreshTime();
+         return;
       }
       else
       {
-         unsigned x = (code >> EV_X_LSB) & 0xFF;
-         unsigned y = (code >> EV_Y_LSB) & 0xFF;
+         unsigned x, y;
+         Minefield::decodePlot(code, x, y);
 
          if(code & EV_FLAG)
          {
@@ -116,14 +140,15 @@ private:
       refresh();
    }
 
-   //! Refresh the GUI state
+   //! Refresh the GUI state for everything that may have changed
    void refresh()
    {
+      MineSweeper::Stats::ScopedTimer timer{MineSweeper::Stats::REFRESH};
+
       snprintf(text_flags, sizeof(text_flags), "%3d", game.getNumberOfFlags());
       gui_flags.setText(text_flags);
 
-      snprintf(text_time, sizeof(text_time), "%3d", game.getNumberOfTicks());
-      gui_time.setText(text_time);
+      refreshTime();
 
       switch(game.getProgress())
       {
@@ -133,96 +158,96 @@ private:
       case MineSweeper::CLEARED:   gui_reset.text.setText(":-)"); break;
       }
 
-      for(unsigned y = 0; y < GAME_ROWS; ++y)
+      // The minefield paints from the game state, so only whether anything
+      // changed matters, and that is checked without walking the board
+      if(game.getNumberOfChanges() != last_changes)
       {
-         for(unsigned x = 0; x < GAME_COLS; ++x)
-         {
-            GUI::TextButton* b = &gui_btn[x][y];
-
-            STB::Colour fg = GUI::FOREGROUND;
-            STB::Colour bg = GUI::FACE;
-
-            bool mine;
-
-            switch(game.getPlotState(x, y, mine))
-            {
-            case MineSweeper::UNDUG:
-               b->text.setText(" ");
-               b->setSelect(false);
-               break;
-
-            case MineSweeper::FLAG:
-               b->text.setFont(&font_mines);
-               b->text.setText("1");
-               b->setSelect(false);
-               break;
-
-            case MineSweeper::HOLE:
-               if(mine)
-               {
-                  b->text.setFont(&font_mines);
-                  b->text.setText("0");
-               }
-               else
-               {
-                  b->text.setFont(nullptr);
-                  unsigned n = game.getNumberOfAdjacentMines(x, y);
-
-                  switch(n)
-                  {
-                  case 0: fg = 0x000000; b->text.setText(" "); break;
-                  case 1: fg = 0x0000C0; b->text.setText("1"); break;
-                  case 2: fg = 0x008000; b->text.setText("2"); break;
-                  case 3: fg = 0xC00000; b->text.setText("3"); break;
-                  case 4: fg = 0x000040; b->text.setText("4"); break;
-                  case 5: fg = 0x400000; b->text.setText("5"); break;
-                  case 6: fg = 0x008080; b->text.setText("6"); break;
-                  case 7: fg = 0x000000; b->text.setText("7"); break;
-                  case 8: fg = 0x808080; b->text.setText("8"); break;
-                  default: assert(!"Not possible"); break;
-                  }
-               }
-               b->setSelect(true);
-               break;
-
-            case MineSweeper::EXPLOSION:
-               b->text.setFont(&font_mines);
-               b->text.setText("0");
-               bg = 0xE00000;
-               break;
-            }
-
-            b->text.setForegroundColour(fg);
-            b->text.setBackgroundColour(bg);
-            b->setBackgroundColour(bg);
-         }
+         last_changes = game.getNumberOfChanges();
+         gui_field.refresh();
       }
    }
 
-   // Event code fields
-   static const unsigned EV_DIG   = 1 << 16;
-   static const unsigned EV_FLAG  = 1 << 17;
-   static const unsigned EV_X_LSB = 0;
-   static const unsigned EV_Y_LSB = 8;
-   static const unsigned EV_HELP  = 1;
-   static const unsigned EV_RESET = 2;
-   static const unsigned EV_TICK  = 3;
+   //! Scroll or zoom the minefield view
+   void moveView(unsigned code)
+   {
+      // Scroll by a quarter of the view
+      signed step_x = gui_field.getViewWidth() / 4;
+      signed step_y = gui_field.getViewHeight() / 4;
+
+      switch(code)
+      {
+      case EV_ZOOM_IN:  gui_field.zoomBy(+1);           break;
+      case EV_ZOOM_OUT: gui_field.zoomBy(-1);           break;
+      case EV_LEFT:     gui_field.scrollBy(-step_x, 0); break;
+      case EV_RIGHT:    gui_field.scrollBy(+step_x, 0); break;
+      case EV_UP:       gui_field.scrollBy(0, -step_y); break;
+      case EV_DOWN:     gui_field.scrollBy(0, +step_y); break;
+      }
+   }
+
+   //! Add an optional button to the menu bar
+   void addMenuButton(GUI::TextButton& button, unsigned code, const char* text)
+   {
+      gui_menu.pushBack(&button);
+
+      button.setCode(code);
+      button.setFlat();
+      button.text.setText(text);
+   }
+
+   //! Refresh the game timer display
+   void refreshTime()
+   {
+      snprintf(text_time, sizeof(text_time), "%3d", game.getNumberOfTicks());
+      gui_time.setText(text_time);
+   }
+
+   using Minefield = MinefieldWidget<MineSweeper::Game<GAME_COLS, GAME_ROWS>>;
+
+   // Event code fields, the plot co-ordinates are below EV_DIG
+   static const unsigned EV_DIG      = 1 << Minefield::EV_FREE_LSB;
+   static const unsigned EV_FLAG     = 2 << Minefield::EV_FREE_LSB;
+   static const unsigned EV_HELP     = 1;
+   static const unsigned EV_RESET    = 2;
+   static const unsigned EV_TICK     = 3;
+   static const unsigned EV_UNDO     = 4;
+   static const unsigned EV_REDO     = 5;
+   static const unsigned EV_ZOOM_IN  = 6;
+   static const unsigned EV_ZOOM_OUT = 7;
+   static const unsigned EV_LEFT     = 8;
+   static const unsigned EV_RIGHT    = 9;
+   static const unsigned EV_UP       = 10;
+   static const unsigned EV_DOWN     = 11;
+
+   //! Size of the minefield view in plots, larger boards scroll
+   static const unsigned VIEW_COLS = 40;
+   static const unsigned VIEW_ROWS = 24;
+
+   //! Memory budget for undo and redo
+   static const size_t HISTORY_BYTES = 64 * 1024;
+
+   // Game state, constructed before the widgets that show it
+   MineSweeper::Game<GAME_COLS, GAME_ROWS> game;
 
    // GUI components
    GUI::Row        gui_menu{this};
    GUI::TextButton gui_help{&gui_menu, EV_HELP, "Help"};
+   GUI::TextButton gui_undo{&gui_menu, EV_UNDO, "Undo"};
+   GUI::TextButton gui_redo{&gui_menu, EV_REDO, "Redo"};
    GUI::Bar        gui_bar{this};
    GUI::Row        gui_top{this, 8};
    LEDDisplay      gui_flags{&gui_top, 3};
    GUI::TextButton gui_reset{&gui_top, EV_RESET, " X "};
    LEDDisplay      gui_time{&gui_top, 3};
-   GUI::Col        gui_btm{this, 0};
-   GUI::Row        gui_row[GAME_ROWS];
-   GUI::TextButton gui_btn[GAME_COLS][GAME_ROWS];
-
-   char text_flags[8];
-   char text_time[8];
-
-   // Game state
-   MineSweeper::Game<GAME_COLS, GAME_ROWS> game;
+   Minefield       gui_field{this, game, EV_DIG, EV_FLAG, &GUI::font_teletext15, VIEW_COLS, VIEW_ROWS};
+   GUI::TextButton gui_zoom_out;
+   GUI::TextButton gui_zoom_in;
+   GUI::TextButton gui_left;
+   GUI::TextButton gui_right;
+   GUI::TextButton gui_up;
+   GUI::TextButton gui_down;
+
+   char     text_flags[12];
+   char     text_time[8];
+   uint32_t last_changes{0};
 };
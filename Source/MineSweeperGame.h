@@ -22,10 +22,19 @@
 
 #pragma once
 
+#include <algorithm>
 #include <array>
 #include <cassert>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
 
+#include "MineSweeperAdjacency.h"
+#include "MineSweeperBitBoard.h"
+#include "MineSweeperHistory.h"
 #include "MineSweeperPlot.h"
+#include "MineSweeperRandom.h"
+#include "MineSweeperStats.h"
 
 namespace MineSweeper {
 
@@ -38,17 +47,79 @@ enum Progress : uint8_t
    CLEARED
 };
 
+//! A single player move
+struct Move
+{
+   enum Type : uint8_t
+   {
+      DIG,
+      FLAG   //!< Plant or unplant a flag
+   };
+
+   uint16_t x;
+   uint16_t y;
+   Type     type;
+};
+
+//! What changed when a batch of moves was applied
+struct MoveSummary
+{
+   uint32_t applied;  //!< Moves applied before the game ended or the batch ran out
+   uint32_t holes;    //!< Plots dug, including those opened by flood fill
+   int32_t  flags;    //!< Change in the number of flags planted
+   Progress progress; //!< Game state after the batch
+};
+
+//! Column and row offsets of the eight plots around a plot
+static constexpr unsigned NUM_NEIGHBOURS = 8;
+static constexpr int8_t   NEIGHBOUR_X[NUM_NEIGHBOURS] = {-1,  0,  1, -1, 1, -1, 0, 1};
+static constexpr int8_t   NEIGHBOUR_Y[NUM_NEIGHBOURS] = {-1, -1, -1,  0, 0,  1, 1, 1};
+
+//! Smallest counter type that can count every plot on a board
+template <unsigned PLOTS>
+using Counter = typename std::conditional<PLOTS <= 0xFFFF, uint16_t, uint32_t>::type;
+
 //! Mine sweeper game
 template <unsigned WIDTH, unsigned HEIGHT>
 class Game
 {
 public:
-   Game(unsigned number_of_mines_)
+   using Count = Counter<WIDTH * HEIGHT>;
+
+   //! Complete game state as a fixed size, trivially copyable, blob
+   //
+   //  About three bits per plot, so suited to keeping many positions. To
+   //  try a move and throw the result away use a GameFork
+   struct Snapshot
+   {
+      BitBoard<WIDTH, HEIGHT>                       mines;
+      std::array<uint8_t, (WIDTH * HEIGHT + 3) / 4> visible; //!< 2-bit State per plot
+      Random                                        random;
+      uint32_t                                      number_of_ticks;
+      Count                                         number_of_mines;
+      Count                                         number_of_flags;
+      Count                                         number_of_holes;
+      Progress                                      progress;
+      SafeZone                                      safe_zone;
+   };
+
+   Game(unsigned number_of_mines_, uint64_t seed = 1)
       : number_of_mines(number_of_mines_)
+      , random(seed)
    {
+      // Small boards never grow the stack while digging, large boards
+      // only pay for the stack their flood fills actually need
+      dig_stack.reserve(std::min(WIDTH * HEIGHT, unsigned(DIG_STACK_RESERVE)));
+
       reset();
    }
 
+   //! Width of the board
+   static unsigned getWidth() { return WIDTH; }
+
+   //! Height of the board
+   static unsigned getHeight() { return HEIGHT; }
+
    //! Return current game state
    Progress getProgress() const { return progress; }
 
@@ -64,52 +135,171 @@ public:
       return getPlot(x, y).getState(mine);
    }
 
+   //! Visible code for a plot, CODE_XXX or the adjacent mine count for a hole
+   uint8_t getVisibleCode(unsigned x, unsigned y) const
+   {
+      bool mine;
+
+      switch(getPlotState(x, y, mine))
+      {
+      case UNDUG:     return CODE_UNDUG;
+      case FLAG:      return CODE_FLAG;
+      case EXPLOSION: return CODE_EXPLOSION;
+      default:        break;
+      }
+
+      return mine ? CODE_MINE : uint8_t(getNumberOfAdjacentMines(x, y));
+   }
+
+   //! Number of plot state changes so far, wraps, compare for inequality only
+   //
+   //  Lets a view poll for changes without walking every plot of a very
+   //  large board
+   uint32_t getNumberOfChanges() const { return number_of_changes; }
+
+   //! Call fn(x, y) for every plot whose state has changed since the last call
+   template <typename FN>
+   void forEachChangedPlot(FN fn)
+   {
+      changed.forEach(fn);
+      changed.clearAll();
+   }
+
    //! Total number of mines adjacent to the given location
    unsigned getNumberOfAdjacentMines(signed x, signed y) const
    {
-      unsigned count = 0;
+      assert(isValidPlot(x, y));
+
+      unsigned index = y * WIDTH + x;
+
+      return (adjacent[index / 2] >> ((index % 2) * 4)) & 0xF;
+   }
 
-      for(signed scan_y = std::max(y - 1, 0);
-          scan_y <= std::min(y + 1, signed(HEIGHT - 1));
-          ++scan_y)
+   //! Choose how much of the board is kept clear of mines for the first dig
+   void setSafeZone(SafeZone safe_zone_) { safe_zone = safe_zone_; }
+
+   //! Reset ready for new game with the layout generated from the given seed
+   void reset(uint64_t seed)
+   {
+      random.seed(seed);
+      reset();
+   }
+
+   //! Reset ready for new game
+   void reset()
+   {
+      clearField();
+      plant(nullptr, 0);
+      restart();
+   }
+
+   //! Reset ready for new game with the given mine layout
+   void reset(const BitBoard<WIDTH, HEIGHT>& mines)
+   {
+      clearField();
+
+      mines.forEach([this](unsigned x, unsigned y) { getPlot(x, y).plantMine(); });
+      setAdjacentMines(mines);
+
+      number_of_mines = mines.count();
+      restart();
+   }
+
+   //! Save the complete game state
+   void save(Snapshot& snapshot) const
+   {
+      snapshot.mines.clearAll();
+      snapshot.visible.fill(0);
+
+      // Column by column to match the layout of field
+      for(unsigned x = 0; x < WIDTH; ++x)
       {
-         for(signed scan_x = std::max(x - 1, 0);
-             scan_x <= std::min(x + 1, signed(WIDTH - 1));
-             ++scan_x)
+         for(unsigned y = 0; y < HEIGHT; ++y)
          {
-            if(getPlot(scan_x, scan_y).isMined()) ++count;
+            bool     mine;
+            unsigned index = y * WIDTH + x;
+
+            snapshot.visible[index / 4] |= field[x][y].getState(mine) << ((index % 4) * 2);
+            if(mine) snapshot.mines.set(x, y);
          }
       }
 
-      return count;
+      snapshot.random          = random;
+      snapshot.number_of_ticks = number_of_ticks;
+      snapshot.number_of_mines = number_of_mines;
+      snapshot.number_of_flags = number_of_flags;
+      snapshot.number_of_holes = number_of_holes;
+      snapshot.progress        = progress;
+      snapshot.safe_zone       = safe_zone;
    }
 
-   //! Reset ready for new game
-   void reset()
+   //! Restore the complete game state saved by save()
+   void restore(const Snapshot& snapshot)
    {
-      for(auto& column : field)
+      for(unsigned x = 0; x < WIDTH; ++x)
       {
-         for(auto& plot : column)
+         for(unsigned y = 0; y < HEIGHT; ++y)
          {
-            plot.reset();
+            unsigned index = y * WIDTH + x;
+            State    state = State((snapshot.visible[index / 4] >> ((index % 4) * 2)) & 3);
+
+            field[x][y].restore(state, snapshot.mines.test(x, y));
          }
       }
 
-      for(unsigned planted = 0; planted < number_of_mines;)
+      setAdjacentMines(snapshot.mines);
+
+      random          = snapshot.random;
+      number_of_ticks = snapshot.number_of_ticks;
+      number_of_mines = snapshot.number_of_mines;
+      number_of_flags = snapshot.number_of_flags;
+      number_of_holes = snapshot.number_of_holes;
+      progress        = snapshot.progress;
+      safe_zone       = snapshot.safe_zone;
+
+      changed.setAll();
+      ++number_of_changes;
+      if(history) history->clear();
+   }
+
+   //! Record moves for undo and redo within the given memory budget, zero to disable
+   void enableHistory(size_t max_bytes) { history.setLimit(max_bytes); }
+
+   //! Approximate memory used by the undo and redo history
+   size_t getHistoryBytes() const { return history ? history->getBytes() : 0; }
+
+   //! Check if there is a move to undo
+   bool canUndo() const { return history && history->canUndo(); }
+
+   //! Check if there is an undone move to redo
+   bool canRedo() const { return history && history->canRedo(); }
+
+   //! Undo the last move, returns false if there was nothing to undo
+   bool undo()
+   {
+      History::Counters counters;
+
+      if(!history || !history->undo(counters, [this](uint32_t index, State state){ setPlotState(index, state); }))
       {
-         unsigned x = rand() % WIDTH;
-         unsigned y = rand() % HEIGHT;
+         return false;
+      }
 
-         if(getPlot(x, y).plantMine())
-         {
-            planted++;
-         }
+      setCounters(counters);
+      return true;
+   }
+
+   //! Redo the last move undone, returns false if there was nothing to redo
+   bool redo()
+   {
+      History::Counters counters;
+
+      if(!history || !history->redo(counters, [this](uint32_t index, State state){ setPlotState(index, state); }))
+      {
+         return false;
       }
 
-      number_of_flags = number_of_mines;
-      number_of_holes = 0;
-      number_of_ticks = 0;
-      progress        = RESET;
+      setCounters(counters);
+      return true;
    }
 
    //! Plant or unplant a flag in an undug plot
@@ -120,24 +310,156 @@ public:
          return;
       }
 
-      if(getPlot(x, y).toggleFlag(number_of_flags))
+      beginMove();
+
+      Plot& plot = getPlot(x, y);
+      bool  mine;
+      State before = plot.getState(mine);
+
+      if(plot.toggleFlag(number_of_flags))
       {
          checkIfCleared();
       }
+
+      if(plot.getState(mine) != before)
+      {
+         setChanged(x, y, before);
+      }
+
+      endMove();
    }
 
    //! Dig a hole in an undug plot
    void digHole(unsigned x, unsigned y)
    {
-      Plot& plot = getPlot(x, y);
+      beginMove();
+      dig(x, y);
+      endMove();
+   }
 
-      if(progress == RESET)
+   //! Apply moves in order, stopping when the game ends, as if made one call at a time
+   //
+   //  The batch is one step for undo and redo. Whether the board has been
+   //  cleared is only checked at the end, and before removing a flag as that
+   //  is the only move that could change a cleared board
+   MoveSummary applyMoves(const Move* moves, size_t count)
+   {
+      beginMove();
+
+      Count holes_before = number_of_holes;
+      Count flags_before = number_of_flags;
+
+      size_t i = 0;
+
+      for(; (i < count) && (progress == RESET); ++i)
+      {
+         if(moves[i].type == Move::DIG) dig(moves[i].x, moves[i].y);
+      }
+
+      for(; (i < count) && (progress == CLEARING); ++i)
       {
-         while(!plot.startDig())
+         const Move& move = moves[i];
+         Plot&       plot = getPlot(move.x, move.y);
+         bool        mine;
+         State       state = plot.getState(mine);
+
+         if(move.type == Move::DIG)
          {
-            // re-plant if the first dig fails
-            reset();
+            if(state != UNDUG) continue;
+
+            Stats::add(Stats::DIGS);
+
+            if(plot.startDig())
+            {
+               tryDig(move.x, move.y);
+            }
+            else
+            {
+               setChanged(move.x, move.y, UNDUG);
+               showMines();
+               progress = DETONATED;
+            }
          }
+         else if(state == FLAG)
+         {
+            checkIfCleared();
+            if(progress != CLEARING) break;
+
+            plot.toggleFlag(number_of_flags);
+            setChanged(move.x, move.y, FLAG);
+         }
+         else if((state == UNDUG) && plot.toggleFlag(number_of_flags))
+         {
+            setChanged(move.x, move.y, UNDUG);
+         }
+      }
+
+      if(progress == CLEARING) checkIfCleared();
+
+      endMove();
+
+      return {uint32_t(i), uint32_t(number_of_holes - holes_before),
+              int32_t(flags_before) - int32_t(number_of_flags), progress};
+   }
+
+   //! Increment game timer
+   void tick()
+   {
+      if(progress == CLEARING)
+      {
+         ++number_of_ticks;
+      }
+   }
+
+private:
+   static bool isValidPlot(signed x, signed y)
+   {
+      return (x >= 0) && (x < signed(WIDTH)) &&
+             (y >= 0) && (y < signed(HEIGHT));
+   }
+
+   //! Check if all eight plots around a plot are on the board
+   static bool isInterior(signed x, signed y)
+   {
+      return (x > 0) && (x < signed(WIDTH) - 1) &&
+             (y > 0) && (y < signed(HEIGHT) - 1);
+   }
+
+   //! Call fn(x, y) for each of the (up to) eight plots around a plot
+   //
+   //  Interior plots take a path with no bounds checks, which the compiler
+   //  can unroll completely for a fixed board size
+   template <typename FN>
+   static void forEachNeighbour(signed x, signed y, FN fn)
+   {
+      if(isInterior(x, y))
+      {
+         for(unsigned i = 0; i < NUM_NEIGHBOURS; ++i)
+         {
+            fn(x + NEIGHBOUR_X[i], y + NEIGHBOUR_Y[i]);
+         }
+      }
+      else
+      {
+         for(unsigned i = 0; i < NUM_NEIGHBOURS; ++i)
+         {
+            signed scan_x = x + NEIGHBOUR_X[i];
+            signed scan_y = y + NEIGHBOUR_Y[i];
+
+            if(isValidPlot(scan_x, scan_y)) fn(scan_x, scan_y);
+         }
+      }
+   }
+
+   void dig(unsigned x, unsigned y)
+   {
+      Plot& plot = getPlot(x, y);
+
+      if(progress == RESET)
+      {
+         Stats::add(Stats::DIGS);
+
+         clearSafeZone(x, y);
 
          tryDig(x, y);
          progress = CLEARING;
@@ -150,6 +472,8 @@ public:
 
       if(plot.isUndug())
       {
+         Stats::add(Stats::DIGS);
+
          if(plot.startDig())
          {
             tryDig(x, y);
@@ -157,26 +481,63 @@ public:
          }
          else
          {
+            setChanged(x, y, UNDUG);
             showMines();
             progress = DETONATED;
          }
       }
    }
 
-   //! Increment game timer
-   void tick()
+   History::Counters getCounters() const
    {
-      if(progress == CLEARING)
+      return {number_of_flags, number_of_holes, progress};
+   }
+
+   void setCounters(const History::Counters& counters)
+   {
+      number_of_flags = counters.flags;
+      number_of_holes = counters.holes;
+      progress        = Progress(counters.progress);
+   }
+
+   //! Start recording the plots changed by a move
+   void beginMove()
+   {
+      if(history) history->begin(getCounters());
+   }
+
+   //! Finish recording a move
+   void endMove()
+   {
+      if(history)
       {
-         ++number_of_ticks;
+         history->end(getCounters(), [this](uint32_t index)
+         {
+            bool mine;
+            return getPlot(index % WIDTH, index / WIDTH).getState(mine);
+         });
       }
    }
 
-private:
-   static bool isValidPlot(signed x, signed y)
+   //! Mark a plot as changed, noting its previous state for the history
+   void setChanged(unsigned x, unsigned y, State before)
    {
-      return (x >= 0) && (x < signed(WIDTH)) &&
-             (y >= 0) && (y < signed(HEIGHT));
+      changed.set(x, y);
+      ++number_of_changes;
+
+      if(history) history->note(y * WIDTH + x, before);
+   }
+
+   //! Set the visible state of a plot for undo and redo
+   void setPlotState(uint32_t index, State state)
+   {
+      unsigned x    = index % WIDTH;
+      unsigned y    = index / WIDTH;
+      Plot&    plot = getPlot(x, y);
+
+      plot.restore(state, plot.isMined());
+      changed.set(x, y);
+      ++number_of_changes;
    }
 
    void checkIfCleared()
@@ -187,37 +548,173 @@ private:
       }
    }
 
+   //! Dig the given plot and, if it has no adjacent mines, the region around it
    void tryDig(signed x, signed y)
    {
-      if(!isValidPlot(x, y)) return;
+      Count holes_before = number_of_holes;
+
+      if(digPlot(x, y)) floodFill(x, y);
+
+      Stats::add(Stats::CELLS_REVEALED, number_of_holes - holes_before);
+   }
+
+   //! Dig the region around a plot with no adjacent mines
+   void floodFill(signed x, signed y)
+   {
+      // Plots are only pushed as they are dug, so each plot is pushed at
+      // most once and the stack never holds more than the board
+      dig_stack.clear();
+      dig_stack.push_back(y * WIDTH + x);
 
-      if(getPlot(x, y).continueDig())
+      size_t depth = 1;
+
+      while(!dig_stack.empty())
       {
-         ++number_of_holes;
+         unsigned index = dig_stack.back();
+         dig_stack.pop_back();
+
+         signed plot_x = index % WIDTH;
+         signed plot_y = index / WIDTH;
 
-         if(getNumberOfAdjacentMines(x, y) == 0)
+         forEachNeighbour(plot_x, plot_y, [this](signed scan_x, signed scan_y)
          {
-            tryDig(x - 1, y - 1);
-            tryDig(x,     y - 1);
-            tryDig(x + 1, y - 1);
+            if(digPlot(scan_x, scan_y))
+            {
+               dig_stack.push_back(scan_y * WIDTH + scan_x);
+            }
+         });
 
-            tryDig(x - 1, y);
-            tryDig(x + 1, y);
+         if(Stats::ENABLED) depth = std::max(depth, dig_stack.size());
+      }
+
+      Stats::raise(Stats::FLOOD_MAX_DEPTH, depth);
+   }
 
-            tryDig(x - 1, y + 1);
-            tryDig(x,     y + 1);
-            tryDig(x + 1, y + 1);
+   //! Dig a single plot, returns true if the plots around it should be dug too
+   bool digPlot(signed x, signed y)
+   {
+      if(!getPlot(x, y).continueDig()) return false;
+
+      setChanged(x, y, UNDUG);
+      ++number_of_holes;
+
+      return getNumberOfAdjacentMines(x, y) == 0;
+   }
+
+   //! Restart the game with the mines already planted
+   void restart()
+   {
+      Stats::add(Stats::RESETS);
+
+      changed.setAll();
+      ++number_of_changes;
+      if(history) history->clear();
+
+      number_of_flags = number_of_mines;
+      number_of_holes = 0;
+      number_of_ticks = 0;
+      progress        = RESET;
+   }
+
+   void clearField()
+   {
+      for(auto& column : field)
+      {
+         for(auto& plot : column)
+         {
+            plot.reset();
+         }
+      }
+
+      adjacent.fill(0);
+   }
+
+   //! Plant all the mines avoiding the excluded plots
+   void plant(const uint64_t* excluded, unsigned number_excluded)
+   {
+      plantMines(random, WIDTH * HEIGHT, number_of_mines, excluded, number_excluded,
+                 [this](uint64_t index)
+                 {
+                    return getPlot(index % WIDTH, index / WIDTH).isMined();
+                 },
+                 [this](uint64_t index)
+                 {
+                    getPlot(index % WIDTH, index / WIDTH).plantMine();
+                    addAdjacentMine(index % WIDTH, index / WIDTH);
+                 });
+   }
+
+   //! Re-plant, once, if there are any mines in the safe zone around the first dig
+   void clearSafeZone(unsigned x, unsigned y)
+   {
+      uint64_t zone[9];
+      unsigned n = getSafeZone(safe_zone, x, y, WIDTH, HEIGHT, zone);
+
+      if((WIDTH * HEIGHT - n) < number_of_mines)
+      {
+         // Too many mines to keep the neighbourhood clear
+         n = getSafeZone(SAFE_PLOT, x, y, WIDTH, HEIGHT, zone);
+      }
+
+      for(unsigned i = 0; i < n; ++i)
+      {
+         if(getPlot(zone[i] % WIDTH, zone[i] / WIDTH).isMined())
+         {
+            Stats::add(Stats::REPLANTS);
+
+            clearField();
+            plant(zone, n);
+            return;
          }
       }
    }
 
+   //! Set all the adjacent mine counts for a complete layout at once
+   void setAdjacentMines(const BitBoard<WIDTH, HEIGHT>& mines)
+   {
+      static thread_local std::vector<uint8_t> counts;
+
+      counts.resize(WIDTH * HEIGHT + 1);
+      countAdjacent(mines, counts.data());
+      counts[WIDTH * HEIGHT] = 0;
+
+      for(unsigned i = 0; i < adjacent.size(); ++i)
+      {
+         adjacent[i] = counts[2 * i] | (counts[2 * i + 1] << 4);
+      }
+   }
+
+   //! Count a newly planted mine in the adjacent mine counts around it
+   void addAdjacentMine(signed x, signed y)
+   {
+      auto add = [this](signed scan_x, signed scan_y)
+      {
+         unsigned index = scan_y * WIDTH + scan_x;
+
+         adjacent[index / 2] += 1 << ((index % 2) * 4);
+      };
+
+      // The count is for the 3x3 window so includes the mine itself
+      add(x, y);
+      forEachNeighbour(x, y, add);
+   }
+
    void showMines()
    {
-      for(auto& column : field)
+      for(unsigned x = 0; x < WIDTH; ++x)
       {
-         for(auto& plot : column)
+         for(unsigned y = 0; y < HEIGHT; ++y)
          {
-            plot.reveal();
+            Plot& plot = field[x][y];
+
+            if(plot.isMined())
+            {
+               bool  mine;
+               State before = plot.getState(mine);
+
+               plot.reveal();
+               setChanged(x, y, before);
+            }
          }
       }
    }
@@ -237,12 +734,30 @@ private:
    }
 
    Progress progress;
-   uint16_t number_of_mines;
-   uint16_t number_of_flags;
-   uint16_t number_of_holes;
+   Count    number_of_mines;
+   Count    number_of_flags;
+   Count    number_of_holes;
    uint32_t number_of_ticks;
+   SafeZone safe_zone{SAFE_PLOT};
+   Random   random;
 
    std::array<std::array<Plot, HEIGHT>, WIDTH> field;
+
+   //! Adjacent mine count for each plot, packed two 4-bit counts per byte
+   std::array<uint8_t, (WIDTH * HEIGHT + 1) / 2> adjacent;
+
+   //! Plots whose state has changed since the last forEachChangedPlot()
+   BitBoard<WIDTH, HEIGHT> changed;
+   uint32_t                number_of_changes{0};
+
+   //! Plots reserved in the work stack up front
+   static const unsigned DIG_STACK_RESERVE = 64 * 1024;
+
+   //! Work stack for tryDig(), plots still to be expanded
+   std::vector<uint32_t> dig_stack;
+
+   //! Moves for undo and redo, disabled by default
+   HistoryPtr history;
 };
 
 } // namespace MineSweeper
@@ -0,0 +1,329 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 John D. Haughton
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//------------------------------------------------------------------------------
+
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "MineSweeperBitBoard.h"
+#include "MineSweeperGame.h"
+#include "MineSweeperRandom.h"
+#include "MineSweeperSolver.h"
+
+namespace MineSweeper {
+
+//! Bounded lock-free multi-producer multi-consumer queue
+//
+//  Each slot carries a sequence number that tells producers and consumers
+//  whether it is free or full for the current lap of the ring, so a push or
+//  pop is a single compare-and-swap on the head or tail index
+template <typename TYPE>
+class BoundedQueue
+{
+public:
+   BoundedQueue(unsigned capacity_)
+      : capacity(roundUp(capacity_))
+      , slot(new Slot[capacity])
+   {
+      for(unsigned i = 0; i < capacity; ++i)
+      {
+         slot[i].sequence.store(i, std::memory_order_relaxed);
+      }
+   }
+
+   //! Add an item, returns false if the queue is full
+   bool push(const TYPE& item)
+   {
+      uint64_t pos = tail.load(std::memory_order_relaxed);
+
+      for(;;)
+      {
+         Slot&    s    = slot[pos & (capacity - 1)];
+         uint64_t seq  = s.sequence.load(std::memory_order_acquire);
+         int64_t  diff = int64_t(seq) - int64_t(pos);
+
+         if(diff == 0)
+         {
+            if(tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+            {
+               s.item = item;
+               s.sequence.store(pos + 1, std::memory_order_release);
+               return true;
+            }
+         }
+         else if(diff < 0)
+         {
+            return false;
+         }
+         else
+         {
+            pos = tail.load(std::memory_order_relaxed);
+         }
+      }
+   }
+
+   //! Remove an item, returns false if the queue is empty
+   bool pop(TYPE& item)
+   {
+      uint64_t pos = head.load(std::memory_order_relaxed);
+
+      for(;;)
+      {
+         Slot&    s    = slot[pos & (capacity - 1)];
+         uint64_t seq  = s.sequence.load(std::memory_order_acquire);
+         int64_t  diff = int64_t(seq) - int64_t(pos + 1);
+
+         if(diff == 0)
+         {
+            if(head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+            {
+               item = s.item;
+               s.sequence.store(pos + capacity, std::memory_order_release);
+               return true;
+            }
+         }
+         else if(diff < 0)
+         {
+            return false;
+         }
+         else
+         {
+            pos = head.load(std::memory_order_relaxed);
+         }
+      }
+   }
+
+   //! Approximate number of items queued
+   unsigned size() const
+   {
+      return unsigned(tail.load(std::memory_order_relaxed) - head.load(std::memory_order_relaxed));
+   }
+
+private:
+   struct Slot
+   {
+      std::atomic<uint64_t> sequence;
+      TYPE                  item;
+   };
+
+   //! Power of two capacity, at least two so that full and empty slots differ
+   static unsigned roundUp(unsigned n)
+   {
+      unsigned power = 2;
+      while(power < n) power <<= 1;
+      return power;
+   }
+
+   const unsigned          capacity;
+   std::unique_ptr<Slot[]> slot;
+
+   alignas(64) std::atomic<uint64_t> head{0};
+   alignas(64) std::atomic<uint64_t> tail{0};
+};
+
+//! A mine layout and the plot to start digging from
+template <unsigned WIDTH, unsigned HEIGHT>
+struct Layout
+{
+   BitBoard<WIDTH, HEIGHT> mines;
+   uint16_t                start_x{0};
+   uint16_t                start_y{0};
+   bool                    no_guess{true}; //!< false for a plain layout, see NoGuessGenerator::getLayout()
+};
+
+//! Generates layouts that can be cleared from the start plot without guessing
+//
+//  Worker threads generate random candidates, clear the neighbourhood of a
+//  random start plot, and keep those the deterministic Solver can clear
+//  completely. Accepted layouts wait in a bounded lock-free pool so that
+//  reset() normally just pops one. If the pool is empty the caller's thread
+//  generates a layout itself, giving up after a limited number of attempts
+//  as some densities admit no layout, or very few, that needs no guessing
+template <unsigned WIDTH, unsigned HEIGHT>
+class NoGuessGenerator
+{
+public:
+   NoGuessGenerator(unsigned number_of_mines_,
+                    unsigned number_of_threads = 0,
+                    unsigned pool_size         = 64,
+                    uint64_t seed              = 1)
+      : number_of_mines(number_of_mines_)
+      , pool(pool_size)
+   {
+      if(number_of_threads == 0)
+      {
+         // hardware_concurrency() may report 0 when unknown
+         unsigned hc = std::thread::hardware_concurrency();
+         number_of_threads = hc > 1 ? hc - 1 : 1;
+      }
+
+      for(unsigned i = 0; i < number_of_threads; ++i)
+      {
+         // workers use distinct seeds so they never produce the same layouts
+         worker.emplace_back([this, i, seed]{ work(seed + i + 1); });
+      }
+
+      // seed for layouts generated on demand
+      local.reset(new Candidate(number_of_mines, seed));
+   }
+
+   ~NoGuessGenerator()
+   {
+      running = false;
+
+      for(auto& thread : worker) thread.join();
+   }
+
+   //! Approximate number of layouts ready
+   unsigned getPoolSize() const { return pool.size(); }
+
+   //! Limit the candidates tried on the caller's thread when the pool is empty
+   void setMaxAttempts(unsigned max_attempts_) { max_attempts = std::max(1u, max_attempts_); }
+
+   //! Next layout that can be solved without guessing
+   //
+   //  If the pool is empty and no candidate tried on the caller's thread
+   //  needs no guessing, the last candidate is returned as a plain layout,
+   //  still with a safe start, and with no_guess false
+   Layout<WIDTH, HEIGHT> getLayout()
+   {
+      Layout<WIDTH, HEIGHT> layout;
+
+      if(pool.pop(layout)) return layout;
+
+      for(unsigned attempt = 0; attempt < max_attempts; ++attempt)
+      {
+         if(local->generate(layout)) return layout;
+      }
+
+      local->getMines(layout);
+      layout.no_guess = false;
+
+      return layout;
+   }
+
+   //! Reset a game with a new layout and dig the start plot, returns false if the layout may need guessing
+   bool reset(Game<WIDTH, HEIGHT>& game)
+   {
+      Layout<WIDTH, HEIGHT> layout = getLayout();
+
+      game.reset(layout.mines);
+      game.digHole(layout.start_x, layout.start_y);
+
+      return layout.no_guess;
+   }
+
+private:
+   //! State needed to generate and check candidate layouts
+   struct Candidate
+   {
+      Candidate(unsigned number_of_mines, uint64_t seed)
+         : random(seed)
+         , game(number_of_mines, seed)
+      {
+         game.setSafeZone(SAFE_NEIGHBOURHOOD);
+      }
+
+      //! Try one random candidate, returns true if it needs no guessing
+      bool generate(Layout<WIDTH, HEIGHT>& layout)
+      {
+         layout.start_x = random.below(WIDTH);
+         layout.start_y = random.below(HEIGHT);
+
+         game.reset(random());
+         game.digHole(layout.start_x, layout.start_y);
+
+         solver.play(game);
+
+         if(game.getProgress() != CLEARED) return false;
+
+         getMines(layout);
+         layout.no_guess = true;
+
+         return true;
+      }
+
+      //! Copy the mines of the last candidate tried into a layout
+      void getMines(Layout<WIDTH, HEIGHT>& layout) const
+      {
+         layout.mines.clearAll();
+
+         for(unsigned y = 0; y < HEIGHT; ++y)
+         {
+            for(unsigned x = 0; x < WIDTH; ++x)
+            {
+               bool mine;
+               game.getPlotState(x, y, mine);
+               if(mine) layout.mines.set(x, y);
+            }
+         }
+      }
+
+      Random                random;
+      Game<WIDTH, HEIGHT>   game;
+      Solver<WIDTH, HEIGHT> solver;
+   };
+
+   void work(uint64_t seed)
+   {
+      std::unique_ptr<Candidate> candidate{new Candidate(number_of_mines, seed)};
+
+      Layout<WIDTH, HEIGHT> layout;
+      bool                  have_layout = false;
+
+      while(running)
+      {
+         if(!have_layout)
+         {
+            have_layout = candidate->generate(layout);
+         }
+         else if(pool.push(layout))
+         {
+            have_layout = false;
+         }
+         else
+         {
+            // pool is full
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+         }
+      }
+   }
+
+   //! Default limit on candidates tried on the caller's thread
+   static const unsigned DEFAULT_MAX_ATTEMPTS = 10000;
+
+   unsigned                              number_of_mines;
+   unsigned                              max_attempts{DEFAULT_MAX_ATTEMPTS};
+   BoundedQueue<Layout<WIDTH, HEIGHT>>   pool;
+   std::atomic<bool>                     running{true};
+   std::vector<std::thread>              worker;
+   std::unique_ptr<Candidate>            local;
+};
+
+} // namespace MineSweeper
@@ -0,0 +1,415 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 John D. Haughton
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//------------------------------------------------------------------------------
+
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include "MineSweeperPlot.h"
+
+namespace MineSweeper {
+
+//! Undo and redo history of moves stored as compact deltas
+//
+//  While a move is made the engine notes the index and previous State of
+//  each plot it changes. When the move ends the changes are grouped by
+//  their before and after States and each group is stored as runs of
+//  consecutive plot indices, so the large region opened by a single dig
+//  costs a few bytes per row rather than a copy of the board. The oldest
+//  moves are dropped when the history would exceed its memory limit, which
+//  also covers the work space kept for grouping the changes of a move
+class History
+{
+public:
+   //! Game counters saved either side of a move
+   struct Counters
+   {
+      uint32_t flags;
+      uint32_t holes;
+      uint8_t  progress;
+   };
+
+   //! Set the memory budget in bytes, zero disables the history
+   void setLimit(size_t limit_)
+   {
+      limit = limit_;
+      clear();
+   }
+
+   //! Check if moves are being recorded
+   bool isEnabled() const { return limit != 0; }
+
+   //! Forget all moves
+   void clear()
+   {
+      undo_list.clear();
+      redo_list.clear();
+      pending.clear();
+      bytes = 0;
+      trimWorkSpace();
+   }
+
+   bool canUndo() const { return !undo_list.empty(); }
+   bool canRedo() const { return !redo_list.empty(); }
+
+   //! Approximate memory used by the recorded moves and the work space
+   size_t getBytes() const { return bytes + getWorkSpaceBytes(); }
+
+   //! Start recording a move
+   void begin(const Counters& before_)
+   {
+      pending.clear();
+      before = before_;
+   }
+
+   //! Note a plot changed by the move, only the first change to a plot is kept
+   void note(uint32_t index, State state)
+   {
+      pending.push_back({index, uint8_t(state), 0});
+   }
+
+   //! Finish recording a move, get_state(index) returns the current State of a plot
+   template <typename GET_STATE>
+   void end(const Counters& after, GET_STATE get_state)
+   {
+      Delta delta;
+      delta.before = before;
+      delta.after  = after;
+
+      collect(get_state);
+
+      if(pending.empty() && (after.flags == before.flags) && (after.holes == before.holes) &&
+         (after.progress == before.progress))
+      {
+         // Nothing changed
+         trimWorkSpace();
+         return;
+      }
+
+      encode(delta.cells);
+      trimWorkSpace();
+
+      bytes += delta.getBytes();
+      undo_list.push_back(std::move(delta));
+
+      for(const auto& d : redo_list) bytes -= d.getBytes();
+      redo_list.clear();
+
+      while((getBytes() > limit) && (undo_list.size() > 1))
+      {
+         bytes -= undo_list.front().getBytes();
+         undo_list.pop_front();
+      }
+   }
+
+   //! Undo the last move, set_state(index, state) restores a plot
+   template <typename SET_STATE>
+   bool undo(Counters& counters, SET_STATE set_state)
+   {
+      if(undo_list.empty()) return false;
+
+      Delta& delta = undo_list.back();
+
+      decode(delta.cells, [&](uint32_t index, State before, State){ set_state(index, before); });
+      counters = delta.before;
+
+      redo_list.push_back(std::move(delta));
+      undo_list.pop_back();
+      return true;
+   }
+
+   //! Redo the last move undone, set_state(index, state) restores a plot
+   template <typename SET_STATE>
+   bool redo(Counters& counters, SET_STATE set_state)
+   {
+      if(redo_list.empty()) return false;
+
+      Delta& delta = redo_list.back();
+
+      decode(delta.cells, [&](uint32_t index, State, State after){ set_state(index, after); });
+      counters = delta.after;
+
+      undo_list.push_back(std::move(delta));
+      redo_list.pop_back();
+      return true;
+   }
+
+private:
+   struct Change
+   {
+      uint32_t index;
+      uint8_t  before;
+      uint8_t  after;
+
+      uint8_t transition() const { return (before << 2) | after; }
+   };
+
+   struct Delta
+   {
+      Counters             before;
+      Counters             after;
+      std::vector<uint8_t> cells;
+
+      size_t getBytes() const { return sizeof(Delta) + cells.capacity(); }
+   };
+
+   static const uint8_t END         = 0xFF;
+   static const unsigned TRANSITIONS = 16;
+
+   //! Replace the noted changes with one per plot, grouped by transition and in index order
+   //
+   //  Uses only the pending and sorted vectors as work space so the cost of
+   //  a move depends on the number of plots it changed, not how far apart
+   //  they are on the board
+   template <typename GET_STATE>
+   void collect(GET_STATE get_state)
+   {
+      if(pending.empty()) return;
+
+      uint32_t hi = 0;
+      for(const auto& change : pending) hi = std::max(hi, change.index);
+
+      // Stable radix sort by index, a byte at a time, so that the first
+      // change noted for a plot stays ahead of any later ones
+      sorted.resize(pending.size());
+
+      for(unsigned shift = 0; (shift < 32) && ((hi >> shift) != 0); shift += 8)
+      {
+         unsigned count[256 + 1] = {};
+
+         for(const auto& change : pending) ++count[((change.index >> shift) & 0xFF) + 1];
+
+         for(unsigned d = 1; d <= 256; ++d) count[d] += count[d - 1];
+
+         for(const auto& change : pending) sorted[count[(change.index >> shift) & 0xFF]++] = change;
+
+         pending.swap(sorted);
+      }
+
+      // Keep the earliest before State of each plot that ends up different
+      unsigned count[TRANSITIONS + 1] = {};
+
+      sorted.clear();
+
+      for(size_t i = 0; i < pending.size(); ++i)
+      {
+         if((i > 0) && (pending[i].index == pending[i - 1].index)) continue;
+
+         Change change = pending[i];
+         change.after = uint8_t(get_state(change.index));
+
+         if(change.after != change.before)
+         {
+            sorted.push_back(change);
+            ++count[change.transition() + 1];
+         }
+      }
+
+      // Counting sort by transition, scanning in index order keeps each group sorted
+      for(unsigned t = 1; t <= TRANSITIONS; ++t) count[t] += count[t - 1];
+
+      pending.resize(sorted.size());
+
+      for(const auto& change : sorted)
+      {
+         pending[count[change.transition()]++] = change;
+      }
+   }
+
+   //! Memory held by the work space between moves
+   size_t getWorkSpaceBytes() const
+   {
+      return (pending.capacity() + sorted.capacity()) * sizeof(Change) + runs.capacity() * sizeof(Run);
+   }
+
+   //! Give back work space grown by an unusually large move
+   void trimWorkSpace()
+   {
+      if(getWorkSpaceBytes() > limit / 2)
+      {
+         std::vector<Change>().swap(pending);
+         std::vector<Change>().swap(sorted);
+         std::vector<Run>().swap(runs);
+      }
+   }
+
+   static void putVarint(std::vector<uint8_t>& buffer, uint32_t value)
+   {
+      while(value >= 0x80)
+      {
+         buffer.push_back(uint8_t(value) | 0x80);
+         value >>= 7;
+      }
+
+      buffer.push_back(uint8_t(value));
+   }
+
+   static uint32_t getVarint(const uint8_t*& ptr)
+   {
+      uint32_t value = 0;
+
+      for(unsigned shift = 0; ; shift += 7)
+      {
+         uint8_t byte = *ptr++;
+         value |= uint32_t(byte & 0x7F) << shift;
+         if((byte & 0x80) == 0) return value;
+      }
+   }
+
+   //! Each group is a transition byte, the number of runs, then a gap and length per run
+   void encode(std::vector<uint8_t>& cells)
+   {
+      for(size_t i = 0; i < pending.size();)
+      {
+         uint8_t transition = pending[i].transition();
+
+         size_t group_end = i;
+         while((group_end < pending.size()) && (pending[group_end].transition() == transition)) ++group_end;
+
+         runs.clear();
+         for(size_t j = i; j < group_end; ++j)
+         {
+            if(!runs.empty() && (runs.back().start + runs.back().length == pending[j].index))
+               ++runs.back().length;
+            else
+               runs.push_back({pending[j].index, 1});
+         }
+
+         cells.push_back(transition);
+         putVarint(cells, runs.size());
+
+         uint32_t prev_end = 0;
+         for(const auto& run : runs)
+         {
+            putVarint(cells, run.start - prev_end);
+            putVarint(cells, run.length);
+            prev_end = run.start + run.length;
+         }
+
+         i = group_end;
+      }
+
+      cells.push_back(uint8_t(END));
+      cells.shrink_to_fit();
+   }
+
+   template <typename FN>
+   static void decode(const std::vector<uint8_t>& cells, FN fn)
+   {
+      const uint8_t* ptr = cells.data();
+
+      for(uint8_t transition = *ptr++; transition != END; transition = *ptr++)
+      {
+         State before = State(transition >> 2);
+         State after  = State(transition & 3);
+
+         uint32_t number_of_runs = getVarint(ptr);
+         uint32_t prev_end       = 0;
+
+         for(uint32_t r = 0; r < number_of_runs; ++r)
+         {
+            uint32_t start  = prev_end + getVarint(ptr);
+            uint32_t length = getVarint(ptr);
+
+            for(uint32_t index = start; index < start + length; ++index)
+            {
+               fn(index, before, after);
+            }
+
+            prev_end = start + length;
+         }
+      }
+   }
+
+   struct Run
+   {
+      uint32_t start;
+      uint32_t length;
+   };
+
+   size_t               limit{0};
+   size_t               bytes{0};
+   Counters             before{};
+   std::vector<Change>  pending;
+   std::deque<Delta>    undo_list;
+   std::deque<Delta>    redo_list;
+
+   // Work space
+   std::vector<Change>  sorted;
+   std::vector<Run>     runs;
+};
+
+//! History owned by a game, allocated only while it is enabled
+//
+//  A disabled history is a null pointer, so constructing or copying a game
+//  that does not record moves costs no allocations
+class HistoryPtr
+{
+public:
+   HistoryPtr() = default;
+
+   HistoryPtr(const HistoryPtr& other)
+      : ptr(other.ptr ? new History(*other.ptr) : nullptr)
+   {
+   }
+
+   HistoryPtr(HistoryPtr&&) = default;
+
+   HistoryPtr& operator=(const HistoryPtr& other)
+   {
+      if(this != &other)
+      {
+         ptr.reset(other.ptr ? new History(*other.ptr) : nullptr);
+      }
+
+      return *this;
+   }
+
+   HistoryPtr& operator=(HistoryPtr&&) = default;
+
+   //! Set the memory budget in bytes, zero releases the history
+   void setLimit(size_t limit)
+   {
+      if(limit == 0)
+      {
+         ptr.reset();
+         return;
+      }
+
+      if(!ptr) ptr.reset(new History);
+      ptr->setLimit(limit);
+   }
+
+   explicit operator bool() const { return bool(ptr); }
+
+   History* operator->() const { return ptr.get(); }
+
+private:
+   std::unique_ptr<History> ptr;
+};
+
+} // namespace MineSweeper
@@ -0,0 +1,518 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 John D. Haughton
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//------------------------------------------------------------------------------
+
+
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "MineSweeperRandom.h"
+
+namespace MineSweeper {
+
+//! Compact append-only log of games
+//
+//  A log file is an 8 byte magic followed by a stream of records. Each
+//  record starts with an unsigned LEB128 varint whose two least significant
+//  bits select the operation and whose remaining bits carry its operand...
+//
+//     DIG   plot index (y * width + x)
+//     FLAG  plot index
+//     TICK  number of consecutive ticks
+//     GAME  safe zone, followed by varints for width, height, mines and seed
+//
+//  A GAME record starts a new game, the records after it up to the next
+//  GAME record are the moves of that game. Replaying the moves against a
+//  game reset with the same seed and safe zone reproduces it exactly
+namespace Log {
+
+static const char MAGIC[8] = {'M', 'S', 'W', 'P', 'L', 'O', 'G', '1'};
+
+enum Op : uint8_t
+{
+   OP_DIG,
+   OP_FLAG,
+   OP_TICK,
+   OP_GAME
+};
+
+//! Append a varint to a buffer
+inline void putVarint(std::vector<uint8_t>& buffer, uint64_t value)
+{
+   while(value >= 0x80)
+   {
+      buffer.push_back(uint8_t(value) | 0x80);
+      value >>= 7;
+   }
+
+   buffer.push_back(uint8_t(value));
+}
+
+//! Read a varint, returns false if the buffer ends first
+inline bool getVarint(const uint8_t*& ptr, const uint8_t* end, uint64_t& value)
+{
+   value = 0;
+
+   for(unsigned shift = 0; (ptr != end) && (shift < 64); shift += 7)
+   {
+      uint8_t byte = *ptr++;
+
+      value |= uint64_t(byte & 0x7F) << shift;
+
+      if((byte & 0x80) == 0) return true;
+   }
+
+   return false;
+}
+
+//! Header of a recorded game
+struct GameInfo
+{
+   unsigned width{0};
+   unsigned height{0};
+   uint64_t mines{0};
+   uint64_t seed{0};
+   SafeZone safe_zone{SAFE_PLOT};
+};
+
+} // namespace Log
+
+//! Buffered writer appending records to a log file
+class LogWriter
+{
+public:
+   LogWriter(const char* filename)
+   {
+      fp = fopen(filename, "ab");
+
+      // The initial position of an append stream is implementation defined
+      if((fp != nullptr) && (fseek(fp, 0, SEEK_END) == 0) && (ftell(fp) == 0))
+      {
+         buffer.insert(buffer.end(), Log::MAGIC, Log::MAGIC + sizeof(Log::MAGIC));
+      }
+   }
+
+   ~LogWriter()
+   {
+      if(fp != nullptr)
+      {
+         flush();
+         fclose(fp);
+      }
+   }
+
+   LogWriter(const LogWriter&) = delete;
+   LogWriter& operator=(const LogWriter&) = delete;
+
+   //! Check the file was opened
+   bool isOpen() const { return fp != nullptr; }
+
+   //! Start a new game
+   void writeGame(const Log::GameInfo& info)
+   {
+      flushTicks();
+      Log::putVarint(buffer, (uint64_t(info.safe_zone) << 2) | Log::OP_GAME);
+      Log::putVarint(buffer, info.width);
+      Log::putVarint(buffer, info.height);
+      Log::putVarint(buffer, info.mines);
+      Log::putVarint(buffer, info.seed);
+      flushIfFull();
+   }
+
+   //! Dig at a plot index
+   void writeDig(uint64_t index) { writeMove(Log::OP_DIG, index); }
+
+   //! Flag or unflag at a plot index
+   void writeFlag(uint64_t index) { writeMove(Log::OP_FLAG, index); }
+
+   //! Game clock tick, consecutive ticks share a record
+   void writeTick() { ++pending_ticks; }
+
+   //! Write buffered records to the file
+   void flush()
+   {
+      flushTicks();
+
+      if((fp != nullptr) && !buffer.empty())
+      {
+         fwrite(buffer.data(), 1, buffer.size(), fp);
+         fflush(fp);
+      }
+
+      buffer.clear();
+   }
+
+private:
+   static const size_t FLUSH_SIZE = 64 * 1024;
+
+   void writeMove(Log::Op op, uint64_t operand)
+   {
+      flushTicks();
+      Log::putVarint(buffer, (operand << 2) | op);
+      flushIfFull();
+   }
+
+   void flushTicks()
+   {
+      if(pending_ticks != 0)
+      {
+         Log::putVarint(buffer, (pending_ticks << 2) | Log::OP_TICK);
+         pending_ticks = 0;
+      }
+   }
+
+   void flushIfFull()
+   {
+      if(buffer.size() >= FLUSH_SIZE) flush();
+   }
+
+   FILE*                fp{nullptr};
+   std::vector<uint8_t> buffer;
+   uint64_t             pending_ticks{0};
+};
+
+//! Wraps a game and records every change made through it
+template <typename GAME>
+class Recorder
+{
+public:
+   Recorder(GAME& game_, LogWriter& writer_)
+      : game(game_)
+      , writer(writer_)
+   {
+   }
+
+   //! The game being recorded
+   const GAME& getGame() const { return game; }
+
+   //! Choose how much of the board is kept clear of mines for the first dig
+   void setSafeZone(SafeZone safe_zone_)
+   {
+      safe_zone = safe_zone_;
+      game.setSafeZone(safe_zone);
+   }
+
+   //! Reset the game with the layout generated from the given seed and start a new log entry
+   void reset(uint64_t seed)
+   {
+      game.reset(seed);
+
+      Log::GameInfo info;
+      info.width     = game.getWidth();
+      info.height    = game.getHeight();
+      info.mines     = game.getNumberOfFlags();
+      info.seed      = seed;
+      info.safe_zone = safe_zone;
+
+      writer.writeGame(info);
+   }
+
+   void plantUnplantFlag(unsigned x, unsigned y)
+   {
+      writer.writeFlag(uint64_t(y) * game.getWidth() + x);
+      game.plantUnplantFlag(x, y);
+   }
+
+   void digHole(unsigned x, unsigned y)
+   {
+      writer.writeDig(uint64_t(y) * game.getWidth() + x);
+      game.digHole(x, y);
+   }
+
+   void tick()
+   {
+      writer.writeTick();
+      game.tick();
+   }
+
+private:
+   GAME&      game;
+   LogWriter& writer;
+   SafeZone   safe_zone{SAFE_PLOT};
+};
+
+//! Read-only memory mapping of a log file
+class LogFile
+{
+public:
+   LogFile(const char* filename)
+   {
+      int fd = open(filename, O_RDONLY);
+      if(fd < 0) return;
+
+      struct stat info;
+
+      if((fstat(fd, &info) == 0) && (info.st_size > 0))
+      {
+         void* ptr = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+         if(ptr != MAP_FAILED)
+         {
+            madvise(ptr, info.st_size, MADV_SEQUENTIAL);
+
+            base = static_cast<const uint8_t*>(ptr);
+            size = info.st_size;
+         }
+      }
+
+      close(fd);
+   }
+
+   ~LogFile()
+   {
+      if(base != nullptr) munmap(const_cast<uint8_t*>(base), size);
+   }
+
+   LogFile(const LogFile&) = delete;
+   LogFile& operator=(const LogFile&) = delete;
+
+   //! Check the file is mapped and starts with the log magic
+   bool isValid() const
+   {
+      return (size >= sizeof(Log::MAGIC)) && (memcmp(base, Log::MAGIC, sizeof(Log::MAGIC)) == 0);
+   }
+
+   //! Records following the magic
+   const uint8_t* begin() const { return base + sizeof(Log::MAGIC); }
+   const uint8_t* end() const { return base + size; }
+
+private:
+   const uint8_t* base{nullptr};
+   size_t         size{0};
+};
+
+//! Reconstructs the state of recorded games
+//
+//  The constructor indexes the start of each game. The first replay of a
+//  game also saves a copy of the game every checkpoint_interval moves so
+//  that later replays to a given move start from the nearest checkpoint.
+//  A move is one record, a run of ticks is a single move
+template <typename GAME>
+class Replayer
+{
+public:
+   static const uint64_t ALL = ~uint64_t(0);
+
+   Replayer(const uint8_t* begin_, const uint8_t* end_, uint64_t checkpoint_interval_ = 4096)
+      : end(end_)
+      , checkpoint_interval(checkpoint_interval_)
+   {
+      index(begin_);
+   }
+
+   //! Number of games in the log
+   size_t getNumberOfGames() const { return games.size(); }
+
+   //! Header of a game
+   const Log::GameInfo& getInfo(size_t game_index) const { return games[game_index].info; }
+
+   //! Number of moves recorded for a game
+   uint64_t getNumberOfMoves(size_t game_index) const { return games[game_index].moves; }
+
+   //! Check every move of a game is consistent with its header
+   bool isReplayable(size_t game_index) const { return games[game_index].valid; }
+
+   //! Replay a game up to the given move, returns false if the game does not match the log
+   //
+   //  The game must have been constructed with the board size and number
+   //  of mines in the header of the recorded game
+   bool replay(GAME& game, size_t game_index, uint64_t moves = ALL)
+   {
+      Entry& entry = games[game_index];
+
+      if(!entry.valid ||
+         (game.getWidth() != entry.info.width) || (game.getHeight() != entry.info.height))
+      {
+         return false;
+      }
+
+      if(moves > entry.moves) moves = entry.moves;
+
+      if(!entry.indexed && !buildCheckpoints(game, entry))
+      {
+         return false;
+      }
+
+      const uint8_t* ptr  = entry.moves_begin;
+      uint64_t       move = 0;
+
+      // start from the last checkpoint at or before the requested move
+      size_t n = moves / checkpoint_interval;
+
+      if(n > 0)
+      {
+         const Checkpoint& checkpoint = entry.checkpoints[n - 1];
+
+         game = checkpoint.game;
+         ptr  = checkpoint.ptr;
+         move = checkpoint.move;
+      }
+      else
+      {
+         start(game, entry.info);
+
+         if(game.getNumberOfFlags() != entry.info.mines) return false;
+      }
+
+      for(; move < moves; ++move)
+      {
+         apply(game, entry.info.width, ptr);
+      }
+
+      return true;
+   }
+
+private:
+   //! Upper bound on the ticks in one game, about six months at one tick per second
+   static const uint64_t MAX_TICKS = uint64_t(1) << 24;
+
+   //! A saved game state and where to continue from
+   struct Checkpoint
+   {
+      uint64_t       move;
+      const uint8_t* ptr;
+      GAME           game;
+   };
+
+   struct Entry
+   {
+      Log::GameInfo           info;
+      const uint8_t*          moves_begin;
+      uint64_t                moves{0};
+      uint64_t                ticks{0};
+      bool                    valid{true};
+      bool                    indexed{false};
+      std::vector<Checkpoint> checkpoints;
+   };
+
+   //! Find the start of each game and check each move against its header
+   //
+   //  A truncated final record is ignored. A game with a plot index off the
+   //  board or an implausible number of ticks is marked as not replayable
+   void index(const uint8_t* ptr)
+   {
+      while(ptr != end)
+      {
+         uint64_t value;
+         if(!Log::getVarint(ptr, end, value)) break;
+
+         uint64_t operand = value >> 2;
+
+         if((value & 3) == Log::OP_GAME)
+         {
+            Entry    entry;
+            uint64_t width, height;
+
+            if(!Log::getVarint(ptr, end, width) || !Log::getVarint(ptr, end, height) ||
+               !Log::getVarint(ptr, end, entry.info.mines) || !Log::getVarint(ptr, end, entry.info.seed))
+            {
+               break;
+            }
+
+            entry.info.width     = unsigned(width);
+            entry.info.height    = unsigned(height);
+            entry.info.safe_zone = SafeZone(operand);
+            entry.moves_begin    = ptr;
+            entry.valid          = (width == entry.info.width) && (height == entry.info.height) &&
+                                   (operand <= SAFE_NEIGHBOURHOOD);
+
+            games.push_back(entry);
+         }
+         else if(!games.empty())
+         {
+            Entry& entry = games.back();
+
+            if((value & 3) == Log::OP_TICK)
+            {
+               entry.ticks += operand;
+
+               if(entry.ticks > MAX_TICKS) entry.valid = false;
+            }
+            else if(operand >= uint64_t(entry.info.width) * entry.info.height)
+            {
+               entry.valid = false;
+            }
+
+            ++entry.moves;
+         }
+      }
+   }
+
+   static void start(GAME& game, const Log::GameInfo& info)
+   {
+      game.setSafeZone(info.safe_zone);
+      game.reset(info.seed);
+   }
+
+   //! Apply the next record of a game that was found valid while indexing
+   void apply(GAME& game, unsigned width, const uint8_t*& ptr) const
+   {
+      uint64_t value;
+      if(!Log::getVarint(ptr, end, value)) return;
+
+      uint64_t operand = value >> 2;
+
+      switch(value & 3)
+      {
+      case Log::OP_DIG:  game.digHole(unsigned(operand % width), unsigned(operand / width)); break;
+      case Log::OP_FLAG: game.plantUnplantFlag(unsigned(operand % width), unsigned(operand / width)); break;
+      case Log::OP_TICK: for(uint64_t i = 0; i < operand; ++i) game.tick(); break;
+      }
+   }
+
+   //! Replay a whole game saving checkpoints, returns false if the game does not match the log
+   bool buildCheckpoints(GAME& game, Entry& entry)
+   {
+      const uint8_t* ptr = entry.moves_begin;
+
+      start(game, entry.info);
+
+      if(game.getNumberOfFlags() != entry.info.mines) return false;
+
+      for(uint64_t move = 0; move < entry.moves;)
+      {
+         apply(game, entry.info.width, ptr);
+
+         if((++move % checkpoint_interval) == 0)
+         {
+            entry.checkpoints.push_back({move, ptr, game});
+         }
+      }
+
+      entry.indexed = true;
+      return true;
+   }
+
+   const uint8_t*     end;
+   uint64_t           checkpoint_interval;
+   std::vector<Entry> games;
+};
+
+} // namespace MineSweeper
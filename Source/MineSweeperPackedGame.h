@@ -0,0 +1,489 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 John D. Haughton
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//------------------------------------------------------------------------------
+
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+
+#include "MineSweeperBitBoard.h"
+#include "MineSweeperGame.h"
+#include "MineSweeperRandom.h"
+
+namespace MineSweeper {
+
+//! Mine sweeper game with the field stored as bit boards
+//
+//  Behaves identically to Game<WIDTH,HEIGHT> but keeps the mines, flags and
+//  holes as separate one-bit-per-plot boards so that a board is several times
+//  smaller and counting, revealing and clearing work a word at a time
+template <unsigned WIDTH, unsigned HEIGHT>
+class PackedGame
+{
+public:
+   PackedGame(unsigned number_of_mines_, uint64_t seed = 1)
+      : number_of_mines(number_of_mines_)
+      , random(seed)
+   {
+      reset();
+   }
+
+   //! Width of the board
+   static unsigned getWidth() { return WIDTH; }
+
+   //! Height of the board
+   static unsigned getHeight() { return HEIGHT; }
+
+   //! Return current game state
+   Progress getProgress() const { return progress; }
+
+   //! Number of available flags
+   unsigned getNumberOfFlags() const { return number_of_flags; }
+
+   //! Number of ticks that the game has been underway
+   unsigned getNumberOfTicks() const { return number_of_ticks; }
+
+   //! State of plot at the given location
+   State getPlotState(unsigned x, unsigned y, bool& mine) const
+   {
+      mine = mines.test(x, y);
+
+      if(isExplosion(x, y))  return EXPLOSION;
+      if(holes.test(x, y))   return HOLE;
+      if(flags.test(x, y))   return FLAG;
+      return UNDUG;
+   }
+
+   //! Total number of mines adjacent to the given location
+   unsigned getNumberOfAdjacentMines(signed x, signed y) const
+   {
+      return mines.countAdjacent(x, y);
+   }
+
+   //! Choose how much of the board is kept clear of mines for the first dig
+   void setSafeZone(SafeZone safe_zone_) { safe_zone = safe_zone_; }
+
+   //! Reset ready for new game with the layout generated from the given seed
+   void reset(uint64_t seed)
+   {
+      random.seed(seed);
+      reset();
+   }
+
+   //! Reset ready for new game
+   void reset()
+   {
+      flags.clearAll();
+      holes.clearAll();
+      explosion = NO_EXPLOSION;
+
+      plant(nullptr, 0);
+
+      number_of_flags = number_of_mines;
+      number_of_holes = 0;
+      number_of_ticks = 0;
+      progress        = RESET;
+   }
+
+   //! Plant or unplant a flag in an undug plot
+   void plantUnplantFlag(unsigned x, unsigned y)
+   {
+      if(progress != CLEARING)
+      {
+         return;
+      }
+
+      if(holes.test(x, y) || isExplosion(x, y))
+      {
+         return;
+      }
+
+      if(flags.test(x, y))
+      {
+         flags.clear(x, y);
+         ++number_of_flags;
+      }
+      else if(number_of_flags > 0)
+      {
+         flags.set(x, y);
+         --number_of_flags;
+         checkIfCleared();
+      }
+   }
+
+   //! Dig a hole in an undug plot
+   void digHole(unsigned x, unsigned y)
+   {
+      if(progress == RESET)
+      {
+         clearSafeZone(x, y);
+
+         tryDig(x, y);
+         progress = CLEARING;
+         return;
+      }
+      else if(progress != CLEARING)
+      {
+         return;
+      }
+
+      if(!flags.test(x, y) && !holes.test(x, y))
+      {
+         if(!mines.test(x, y))
+         {
+            tryDig(x, y);
+            checkIfCleared();
+         }
+         else
+         {
+            explosion = y * WIDTH + x;
+            showMines();
+            progress = DETONATED;
+         }
+      }
+   }
+
+   //! Increment game timer
+   void tick()
+   {
+      if(progress == CLEARING)
+      {
+         ++number_of_ticks;
+      }
+   }
+
+private:
+   using Board = BitBoard<WIDTH, HEIGHT>;
+   using Word  = typename Board::Word;
+   using Row   = std::array<Word, Board::WORDS_PER_ROW>;
+
+   static const unsigned WORD_BITS     = Board::WORD_BITS;
+   static const unsigned WORDS_PER_ROW = Board::WORDS_PER_ROW;
+
+   bool isExplosion(unsigned x, unsigned y) const { return explosion == (y * WIDTH + x); }
+
+   void checkIfCleared()
+   {
+      if((number_of_holes + number_of_mines - number_of_flags) == (WIDTH * HEIGHT))
+      {
+         progress = CLEARED;
+      }
+   }
+
+   //! Plant all the mines avoiding the excluded plots
+   void plant(const uint64_t* excluded, unsigned number_excluded)
+   {
+      mines.clearAll();
+
+      plantMines(random, WIDTH * HEIGHT, number_of_mines, excluded, number_excluded,
+                 [this](uint64_t index) { return mines.test(index % WIDTH, index / WIDTH); },
+                 [this](uint64_t index) { mines.set(index % WIDTH, index / WIDTH); });
+   }
+
+   //! Re-plant, once, if there are any mines in the safe zone around the first dig
+   void clearSafeZone(unsigned x, unsigned y)
+   {
+      uint64_t zone[9];
+      unsigned n = getSafeZone(safe_zone, x, y, WIDTH, HEIGHT, zone);
+
+      if((WIDTH * HEIGHT - n) < number_of_mines)
+      {
+         // Too many mines to keep the neighbourhood clear
+         n = getSafeZone(SAFE_PLOT, x, y, WIDTH, HEIGHT, zone);
+      }
+
+      for(unsigned i = 0; i < n; ++i)
+      {
+         if(mines.test(zone[i] % WIDTH, zone[i] / WIDTH))
+         {
+            plant(zone, n);
+            return;
+         }
+      }
+   }
+
+   //! Reveal the plot and, a row of words at a time, the region opened up by it
+   //
+   //  Rows are filled out along their length in one go and swept downwards
+   //  then upwards, carrying on past the rows that grew in the last pass
+   //  only while each row keeps growing. A pass costs about the rows the
+   //  opening spans and a dig needs a pass for each turn of the opening
+   //  between down and up, rather than a whole board step per plot of its
+   //  length
+   void tryDig(unsigned x, unsigned y)
+   {
+      Board region;
+      region.set(x, y);
+
+      unsigned lo     = y;
+      unsigned hi     = y;
+      unsigned top    = y;
+      unsigned bottom = y;
+
+      for(;;)
+      {
+         unsigned first = lo > 0 ? lo - 1 : 0;
+         unsigned last  = hi < (HEIGHT - 1) ? hi + 1 : hi;
+
+         lo = HEIGHT;
+         hi = 0;
+
+         auto visit = [&](unsigned row)
+         {
+            if(!growRow(region, row)) return false;
+
+            lo = std::min(lo, row);
+            hi = std::max(hi, row);
+            return true;
+         };
+
+         for(unsigned row = first; row < HEIGHT; ++row)
+         {
+            if(!visit(row) && (row >= last)) break;
+         }
+
+         for(unsigned row = last; row-- > 0;)
+         {
+            if(!visit(row) && (row <= first)) break;
+         }
+
+         if(lo > hi) break;
+
+         top    = std::min(top, lo);
+         bottom = std::max(bottom, hi);
+      }
+
+      for(unsigned row = top; row <= bottom; ++row)
+      {
+         for(unsigned i = 0; i < WORDS_PER_ROW; ++i)
+         {
+            holes.row(row)[i] |= region.row(row)[i];
+            number_of_holes   += popCount(region.row(row)[i]);
+         }
+      }
+   }
+
+   //! Grow the region in a row from its cleared plots and those of the rows either side
+   bool growRow(Board& region, unsigned y) const
+   {
+      Row open     = getOpen(y);
+      Row cleared  = getCleared(y);
+      Row neighbor{};
+
+      for(unsigned ny = y - 1; ny != y + 2; ++ny)
+      {
+         if((ny == y) || (ny >= HEIGHT)) continue;
+
+         Row ny_cleared = getCleared(ny);
+
+         for(unsigned i = 0; i < WORDS_PER_ROW; ++i)
+         {
+            neighbor[i] |= region.row(ny)[i] & ny_cleared[i];
+         }
+      }
+
+      Word* plots = region.row(y);
+
+      // Cleared plots reached along the row through other cleared plots,
+      // from those already in the region or next to cleared plots above
+      // and below, then the plots beside them
+      Row through;
+      Row seeds;
+      Row reached = spread(neighbor);
+
+      for(unsigned i = 0; i < WORDS_PER_ROW; ++i)
+      {
+         through[i] = open[i] & cleared[i];
+         seeds[i]   = (plots[i] | (reached[i] & open[i])) & cleared[i];
+      }
+
+      Row filled = fill(seeds, through);
+      Row grown  = spread(filled);
+
+      bool changed = false;
+
+      for(unsigned i = 0; i < WORDS_PER_ROW; ++i)
+      {
+         Word add = ((grown[i] | reached[i]) & open[i]) & ~plots[i];
+
+         if(add != 0)
+         {
+            plots[i] |= add;
+            changed   = true;
+         }
+      }
+
+      return changed;
+   }
+
+   //! Extend the seeds left and right through runs of set bits in through
+   //
+   //  An occluded fill, doubling the shift each step, so a row is filled in
+   //  a few word operations per doubling rather than one plot at a time
+   static Row fill(const Row& seeds, const Row& through)
+   {
+      Row up      = seeds;
+      Row down    = seeds;
+      Row up_by   = through;
+      Row down_by = through;
+
+      for(unsigned shift = 1; shift < WIDTH; shift *= 2)
+      {
+         Row up_shifted      = shiftUp(up, shift);
+         Row up_by_shifted   = shiftUp(up_by, shift);
+         Row down_shifted    = shiftDown(down, shift);
+         Row down_by_shifted = shiftDown(down_by, shift);
+
+         for(unsigned i = 0; i < WORDS_PER_ROW; ++i)
+         {
+            up[i]      |= up_by[i] & up_shifted[i];
+            up_by[i]   &= up_by_shifted[i];
+            down[i]    |= down_by[i] & down_shifted[i];
+            down_by[i] &= down_by_shifted[i];
+         }
+      }
+
+      for(unsigned i = 0; i < WORDS_PER_ROW; ++i) up[i] |= down[i];
+
+      return up;
+   }
+
+   //! Move the bits of a row towards higher x
+   static Row shiftUp(const Row& in, unsigned shift)
+   {
+      Row      out{};
+      unsigned words = shift / WORD_BITS;
+      unsigned bits  = shift % WORD_BITS;
+
+      for(unsigned i = words; i < WORDS_PER_ROW; ++i)
+      {
+         out[i] = Word(in[i - words] << bits);
+
+         if((bits != 0) && (i > words)) out[i] |= in[i - words - 1] >> (WORD_BITS - bits);
+      }
+
+      return out;
+   }
+
+   //! Move the bits of a row towards lower x
+   static Row shiftDown(const Row& in, unsigned shift)
+   {
+      Row      out{};
+      unsigned words = shift / WORD_BITS;
+      unsigned bits  = shift % WORD_BITS;
+
+      for(unsigned i = 0; i + words < WORDS_PER_ROW; ++i)
+      {
+         out[i] = in[i + words] >> bits;
+
+         if((bits != 0) && (i + words + 1 < WORDS_PER_ROW)) out[i] |= Word(in[i + words + 1] << (WORD_BITS - bits));
+      }
+
+      return out;
+   }
+
+   //! Undug, unflagged plots free of mines in a row
+   Row getOpen(unsigned y) const
+   {
+      Row open;
+
+      for(unsigned i = 0; i < WORDS_PER_ROW; ++i)
+      {
+         open[i] = ~(flags.row(y)[i] | holes.row(y)[i] | mines.row(y)[i]) & rowMask(i);
+      }
+
+      return open;
+   }
+
+   //! Plots in a row with no adjacent mines
+   Row getCleared(unsigned y) const
+   {
+      Row near{};
+
+      for(unsigned ny = y - 1; ny != y + 2; ++ny)
+      {
+         if(ny >= HEIGHT) continue;
+
+         for(unsigned i = 0; i < WORDS_PER_ROW; ++i) near[i] |= mines.row(ny)[i];
+      }
+
+      Row cleared = spread(near);
+
+      for(unsigned i = 0; i < WORDS_PER_ROW; ++i) cleared[i] = ~cleared[i] & rowMask(i);
+
+      return cleared;
+   }
+
+   //! Set each bit of a row that is set or has a set neighbour to its left or right
+   static Row spread(const Row& in)
+   {
+      Row out;
+
+      for(unsigned i = 0; i < WORDS_PER_ROW; ++i)
+      {
+         // carry bits across word boundaries for rows wider than one word
+         Word w       = in[i];
+         Word from_lo = i > 0                   ? in[i - 1] >> (WORD_BITS - 1) : 0;
+         Word from_hi = i < (WORDS_PER_ROW - 1) ? Word(in[i + 1] << (WORD_BITS - 1)) : 0;
+
+         out[i] = w | Word(w << 1) | (w >> 1) | from_lo | from_hi;
+      }
+
+      return out;
+   }
+
+   //! Mask of the valid bits in the i'th word of a row
+   static Word rowMask(unsigned i)
+   {
+      unsigned bits = WIDTH - i * WORD_BITS;
+      return bits >= WORD_BITS ? Word(~Word(0)) : Word((Word(1) << bits) - 1);
+   }
+
+   void showMines()
+   {
+      Board hidden_mines = mines;
+      hidden_mines.clear(explosion % WIDTH, explosion / WIDTH);
+
+      flags &= ~hidden_mines;
+      holes |= hidden_mines;
+   }
+
+   static const uint32_t NO_EXPLOSION = ~uint32_t(0);
+
+   using Count = Counter<WIDTH * HEIGHT>;
+
+   Progress progress;
+   Count    number_of_mines;
+   Count    number_of_flags;
+   Count    number_of_holes;
+   uint32_t number_of_ticks;
+   uint32_t explosion;
+   SafeZone safe_zone{SAFE_PLOT};
+   Random   random;
+
+   Board mines;
+   Board flags;
+   Board holes;
+};
+
+} // namespace MineSweeper
@@ -0,0 +1,98 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 John D. Haughton
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//------------------------------------------------------------------------------
+
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "MineSweeperGame.h"
+#include "MineSweeperRandom.h"
+
+namespace MineSweeper {
+
+//! Interface for an automatic player of any of the game engines
+template <typename GAME>
+class Player
+{
+public:
+   virtual ~Player() = default;
+
+   //! Name for reports
+   virtual const char* getName() const = 0;
+
+   //! Prepare for a new game
+   virtual void start(uint64_t seed) { (void) seed; }
+
+   //! Make at least one move that changes the state of the game
+   virtual void move(GAME& game) = 0;
+};
+
+//! Digs undug plots at random, flagging the last plots when they must be mines
+template <typename GAME>
+class RandomPlayer : public Player<GAME>
+{
+public:
+   const char* getName() const override { return "random"; }
+
+   void start(uint64_t seed) override { random.seed(seed); }
+
+   void move(GAME& game) override
+   {
+      undug.clear();
+
+      for(unsigned y = 0; y < game.getHeight(); ++y)
+      {
+         for(unsigned x = 0; x < game.getWidth(); ++x)
+         {
+            bool mine;
+            if(game.getPlotState(x, y, mine) == UNDUG)
+            {
+               undug.push_back(y * game.getWidth() + x);
+            }
+         }
+      }
+
+      if(undug.empty()) return;
+
+      if(undug.size() == game.getNumberOfFlags())
+      {
+         // Every remaining plot must be mined
+         for(uint64_t index : undug)
+         {
+            game.plantUnplantFlag(index % game.getWidth(), index / game.getWidth());
+         }
+         return;
+      }
+
+      uint64_t index = undug[random.below(undug.size())];
+
+      game.digHole(index % game.getWidth(), index / game.getWidth());
+   }
+
+private:
+   Random                random;
+   std::vector<uint64_t> undug;
+};
+
+} // namespace MineSweeper
@@ -36,6 +36,12 @@ enum State : uint8_t
    EXPLOSION
 };
 
+//! Visible plot codes for front-ends, a hole gives its adjacent mine count 0..8
+static const uint8_t CODE_UNDUG     = 9;
+static const uint8_t CODE_FLAG      = 10;
+static const uint8_t CODE_MINE      = 11;
+static const uint8_t CODE_EXPLOSION = 12;
+
 //! Manage all state for a square element of land
 class Plot
 {
@@ -71,7 +77,8 @@ public:
    }
 
    //! Toggle flag
-   bool toggleFlag(uint16_t& number_of_flags)
+   template <typename COUNT>
+   bool toggleFlag(COUNT& number_of_flags)
    {
       if((state == UNDUG) && (number_of_flags > 0))
       {
@@ -104,6 +111,13 @@ public:
       return true;
    }
 
+   //! Set the complete plot state, as saved by getState()
+   void restore(State state_, bool mine_)
+   {
+      state = state_;
+      mine  = mine_;
+   }
+
    //!
    void reveal()
    {
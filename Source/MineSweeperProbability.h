@@ -0,0 +1,478 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 John D. Haughton
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//------------------------------------------------------------------------------
+
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <map>
+#include <vector>
+
+#include "MineSweeperBitBoard.h"
+#include "MineSweeperGame.h"
+
+namespace MineSweeper {
+
+//! Exact probability that each undug plot is mined, from the visible state of a game
+//
+//  The frontier (undug plots next to numbered holes) is split into
+//  independent components linked by shared constraints. Each component is
+//  enumerated a plot at a time with a forward/backward pass over the
+//  distinct sets of remaining constraint counts, so equivalent partial
+//  assignments are merged rather than enumerated again. The components are
+//  then combined with the plots away from the frontier by weighting each
+//  total number of frontier mines by the binomial number of ways to place
+//  the rest. Flags are trusted to be on mines
+template <unsigned WIDTH, unsigned HEIGHT>
+class Probability
+{
+public:
+   Probability()
+      : probability(WIDTH * HEIGHT, 0.0)
+   {
+   }
+
+   //! Compute the probabilities, returns false if the visible state is inconsistent
+   template <typename GAME>
+   bool solve(const GAME& game)
+   {
+      std::fill(probability.begin(), probability.end(), 0.0);
+
+      read(game);
+      findComponents();
+
+      std::vector<Poly> totals;
+
+      for(auto& component : components)
+      {
+         enumerate(component);
+         if(component.total.empty()) return false;
+         totals.push_back(component.total);
+      }
+
+      return combine(totals, game.getNumberOfFlags());
+   }
+
+   //! Probability that the plot at the given location is mined (flags are 1.0, holes 0.0)
+   double getProbability(unsigned x, unsigned y) const
+   {
+      return probability[y * WIDTH + x];
+   }
+
+   //! Number of frontier components found by the last solve()
+   unsigned getNumberOfComponents() const { return components.size(); }
+
+private:
+   //! Coefficient k is the number of ways with k mines
+   using Poly = std::vector<double>;
+
+   struct Constraint
+   {
+      std::vector<uint32_t> plots;  //!< Undug plots, as positions in the component order
+      uint8_t               mines;  //!< Mines still to be found among them
+      uint32_t              last;   //!< Position of the last plot in the component order
+   };
+
+   struct Component
+   {
+      std::vector<uint32_t>   plots;        //!< Plot indices in enumeration order
+      std::vector<Constraint> constraints;
+      Poly                    total;        //!< Ways by number of mines in the component
+      std::vector<Poly>       mined;        //!< Ways each plot is mined by number of mines
+   };
+
+   //! Remaining constraint counts after assigning a prefix of the plots
+   using State = std::vector<uint8_t>;
+
+   template <typename GAME>
+   void read(const GAME& game)
+   {
+      unknown.clearAll();
+      flagged.clearAll();
+      numbers.clear();
+
+      for(unsigned y = 0; y < HEIGHT; ++y)
+      {
+         for(unsigned x = 0; x < WIDTH; ++x)
+         {
+            bool mine;
+            switch(game.getPlotState(x, y, mine))
+            {
+            case UNDUG: unknown.set(x, y); break;
+            case FLAG:  flagged.set(x, y); probability[y * WIDTH + x] = 1.0; break;
+            case HOLE:  if(!mine) numbers.push_back(y * WIDTH + x); break;
+            default: break;
+            }
+         }
+      }
+
+      // Residual count for every numbered hole that has undug neighbours
+      residual.assign(WIDTH * HEIGHT, uint8_t(NO_CONSTRAINT));
+
+      for(uint32_t index : numbers)
+      {
+         unsigned x = index % WIDTH;
+         unsigned y = index / WIDTH;
+
+         if(unknown.getWindow(x, y) == 0) continue;
+
+         unsigned count = game.getNumberOfAdjacentMines(x, y);
+         unsigned flags = flagged.countAdjacent(x, y);
+
+         residual[index] = flags <= count ? uint8_t(count - flags) : INCONSISTENT;
+      }
+   }
+
+   //! Call fn(index) for each undug plot around the given plot
+   template <typename FN>
+   void forEachUnknownAround(uint32_t index, FN fn) const
+   {
+      unsigned window = unknown.getWindow(index % WIDTH, index / WIDTH);
+
+      for(; window != 0; window &= window - 1)
+      {
+         unsigned bit = __builtin_ctz(window);
+         fn(index + (bit / 3 - 1) * WIDTH + (bit % 3) - 1);
+      }
+   }
+
+   //! Group the frontier into components, ordered breadth first to keep states small
+   void findComponents()
+   {
+      components.clear();
+
+      std::vector<uint32_t> position(WIDTH * HEIGHT, uint32_t(NOT_FRONTIER));
+
+      for(uint32_t index : numbers)
+      {
+         if(residual[index] == NO_CONSTRAINT) continue;
+         forEachUnknownAround(index, [&](uint32_t plot){ position[plot] = FRONTIER; });
+      }
+
+      frontier.clearAll();
+      interior = 0;
+
+      unknown.forEach([&](unsigned x, unsigned y)
+      {
+         if(position[y * WIDTH + x] == NOT_FRONTIER)
+            ++interior;
+         else
+            frontier.set(x, y);
+      });
+
+      std::vector<uint32_t> queue;
+
+      for(unsigned start = 0; start < WIDTH * HEIGHT; ++start)
+      {
+         if(position[start] != FRONTIER) continue;
+
+         components.emplace_back();
+         Component& component = components.back();
+
+         queue.assign(1, start);
+         position[start] = 0;
+
+         std::vector<uint32_t> seen_numbers;
+
+         for(unsigned head = 0; head < queue.size(); ++head)
+         {
+            uint32_t plot = queue[head];
+            component.plots.push_back(plot);
+
+            // visit the numbered holes around this plot and the plots around them
+            unsigned x = plot % WIDTH;
+            unsigned y = plot / WIDTH;
+
+            for(signed dy = -1; dy <= 1; ++dy)
+            {
+               for(signed dx = -1; dx <= 1; ++dx)
+               {
+                  signed nx = signed(x) + dx;
+                  signed ny = signed(y) + dy;
+
+                  if((nx < 0) || (nx >= signed(WIDTH)) || (ny < 0) || (ny >= signed(HEIGHT))) continue;
+
+                  uint32_t number = ny * WIDTH + nx;
+
+                  if((residual[number] == NO_CONSTRAINT) || (visited_number[number] == generation))
+                     continue;
+
+                  visited_number[number] = generation;
+                  seen_numbers.push_back(number);
+
+                  forEachUnknownAround(number, [&](uint32_t next)
+                  {
+                     if(position[next] == FRONTIER)
+                     {
+                        position[next] = queue.size();
+                        queue.push_back(next);
+                     }
+                  });
+               }
+            }
+         }
+
+         for(uint32_t number : seen_numbers)
+         {
+            Constraint constraint;
+            constraint.mines = residual[number];
+            constraint.last  = 0;
+
+            forEachUnknownAround(number, [&](uint32_t plot)
+            {
+               constraint.plots.push_back(position[plot]);
+               constraint.last = std::max(constraint.last, position[plot]);
+            });
+
+            component.constraints.push_back(constraint);
+         }
+
+         ++generation;
+      }
+   }
+
+   //! Add b shifted up by shift into a
+   static void addShifted(Poly& a, const Poly& b, unsigned shift)
+   {
+      if(a.size() < b.size() + shift) a.resize(b.size() + shift, 0.0);
+      for(unsigned k = 0; k < b.size(); ++k) a[k + shift] += b[k];
+   }
+
+   static Poly multiply(const Poly& a, const Poly& b)
+   {
+      if(a.empty() || b.empty()) return Poly{};
+
+      Poly result(a.size() + b.size() - 1, 0.0);
+
+      for(unsigned i = 0; i < a.size(); ++i)
+      {
+         if(a[i] == 0.0) continue;
+         for(unsigned j = 0; j < b.size(); ++j) result[i + j] += a[i] * b[j];
+      }
+
+      return result;
+   }
+
+   //! State after assigning the plot at position pos, returns false if inconsistent
+   static bool step(const Component& component, const std::vector<std::vector<uint32_t>>& touching,
+                    uint32_t pos, unsigned mined, State& state)
+   {
+      for(uint32_t c : touching[pos])
+      {
+         const Constraint& constraint = component.constraints[c];
+
+         if(state[c] < mined) return false;
+         state[c] -= mined;
+
+         // all the constraint's plots have been assigned, must be satisfied
+         if((constraint.last == pos) && (state[c] != 0)) return false;
+      }
+
+      return true;
+   }
+
+   //! Count the solutions for one component by number of mines, and for each plot
+   void enumerate(Component& component)
+   {
+      unsigned n = component.plots.size();
+
+      std::vector<std::vector<uint32_t>> touching(n);
+
+      State initial;
+
+      for(unsigned c = 0; c < component.constraints.size(); ++c)
+      {
+         const Constraint& constraint = component.constraints[c];
+
+         if(constraint.mines > constraint.plots.size())
+         {
+            component.total.clear();
+            return;
+         }
+
+         initial.push_back(constraint.mines);
+
+         for(uint32_t pos : constraint.plots) touching[pos].push_back(c);
+      }
+
+      // forward pass, ways to reach each state by number of mines so far
+      std::vector<std::map<State, Poly>> forward(n + 1);
+      forward[0][initial] = Poly{1.0};
+
+      for(unsigned pos = 0; pos < n; ++pos)
+      {
+         for(const auto& entry : forward[pos])
+         {
+            for(unsigned mined = 0; mined <= 1; ++mined)
+            {
+               State next = entry.first;
+               if(step(component, touching, pos, mined, next))
+               {
+                  addShifted(forward[pos + 1][next], entry.second, mined);
+               }
+            }
+         }
+      }
+
+      // backward pass, ways to complete from each reachable state
+      std::vector<std::map<State, Poly>> backward(n + 1);
+
+      for(const auto& entry : forward[n]) backward[n][entry.first] = Poly{1.0};
+
+      component.mined.assign(n, Poly{});
+
+      for(unsigned pos = n; pos-- > 0;)
+      {
+         for(const auto& entry : forward[pos])
+         {
+            Poly& ways = backward[pos][entry.first];
+
+            for(unsigned mined = 0; mined <= 1; ++mined)
+            {
+               State next = entry.first;
+               if(!step(component, touching, pos, mined, next)) continue;
+
+               auto it = backward[pos + 1].find(next);
+               if(it == backward[pos + 1].end()) continue;
+
+               addShifted(ways, it->second, mined);
+
+               if(mined == 1)
+               {
+                  Poly through = multiply(entry.second, it->second);
+                  addShifted(component.mined[pos], through, 1);
+               }
+            }
+         }
+      }
+
+      component.total.clear();
+      for(const auto& entry : forward[n]) addShifted(component.total, entry.second, 0);
+
+      bool any = false;
+      for(double ways : component.total) any = any || (ways > 0.0);
+      if(!any) component.total.clear();
+   }
+
+   static double logChoose(unsigned n, unsigned k)
+   {
+      return std::lgamma(n + 1.0) - std::lgamma(k + 1.0) - std::lgamma(n - k + 1.0);
+   }
+
+   //! Weight the component totals by the ways to place the remaining mines in the interior
+   bool combine(const std::vector<Poly>& totals, uint64_t remaining_mines)
+   {
+      unsigned m = totals.size();
+
+      // products of all the components before and after each one
+      std::vector<Poly> before(m + 1), after(m + 1);
+      before[0] = Poly{1.0};
+      after[m]  = Poly{1.0};
+      for(unsigned c = 0; c < m; ++c)  before[c + 1] = multiply(before[c], totals[c]);
+      for(unsigned c = m; c-- > 0;)    after[c]      = multiply(totals[c], after[c + 1]);
+
+      const Poly& all = before[m];
+
+      // weight for each number of mines on the frontier, scaled to avoid overflow
+      Poly     weight(all.size(), 0.0);
+      double   max_log = -INFINITY;
+
+      for(unsigned k = 0; k < all.size(); ++k)
+      {
+         if((k > remaining_mines) || ((remaining_mines - k) > interior) || (all[k] == 0.0)) continue;
+         max_log = std::max(max_log, logChoose(interior, remaining_mines - k));
+      }
+
+      if(max_log == -INFINITY) return false;
+
+      double total_weight   = 0.0;
+      double interior_mines = 0.0;
+
+      for(unsigned k = 0; k < all.size(); ++k)
+      {
+         if((k > remaining_mines) || ((remaining_mines - k) > interior)) continue;
+
+         weight[k] = std::exp(logChoose(interior, remaining_mines - k) - max_log);
+
+         total_weight   += all[k] * weight[k];
+         interior_mines += all[k] * weight[k] * (remaining_mines - k);
+      }
+
+      if(total_weight == 0.0) return false;
+
+      for(unsigned c = 0; c < m; ++c)
+      {
+         Poly others = multiply(before[c], after[c + 1]);
+         const Component& component = components[c];
+
+         for(unsigned pos = 0; pos < component.plots.size(); ++pos)
+         {
+            const Poly& mined = component.mined[pos];
+            double      sum   = 0.0;
+
+            for(unsigned k = 0; k < mined.size(); ++k)
+            {
+               if(mined[k] == 0.0) continue;
+
+               for(unsigned j = 0; j < others.size(); ++j)
+               {
+                  if((k + j) < weight.size()) sum += mined[k] * others[j] * weight[k + j];
+               }
+            }
+
+            probability[component.plots[pos]] = sum / total_weight;
+         }
+      }
+
+      if(interior > 0)
+      {
+         double p = interior_mines / total_weight / interior;
+
+         unknown.forEach([&](unsigned x, unsigned y)
+         {
+            if(!frontier.test(x, y)) probability[y * WIDTH + x] = p;
+         });
+      }
+
+      return true;
+   }
+
+   static const uint8_t  NO_CONSTRAINT = 0xFF;
+   static const uint8_t  INCONSISTENT  = 0xFE;
+   static const uint32_t NOT_FRONTIER  = ~uint32_t(0);
+   static const uint32_t FRONTIER      = ~uint32_t(1);
+
+   BitBoard<WIDTH, HEIGHT> unknown;
+   BitBoard<WIDTH, HEIGHT> flagged;
+   BitBoard<WIDTH, HEIGHT> frontier;
+   std::vector<uint32_t>   numbers;
+   std::vector<uint8_t>    residual;
+   std::vector<uint32_t>   visited_number = std::vector<uint32_t>(WIDTH * HEIGHT, 0);
+   uint32_t                generation{1};
+   unsigned                interior{0};
+   std::vector<Component>  components;
+   std::vector<double>     probability;
+};
+
+} // namespace MineSweeper
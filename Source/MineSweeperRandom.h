@@ -0,0 +1,163 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 John D. Haughton
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//------------------------------------------------------------------------------
+
+
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+
+namespace MineSweeper {
+
+//! Small, fast and seedable pseudo random number generator (xoshiro256**)
+class Random
+{
+public:
+   Random(uint64_t seed_ = 1) { seed(seed_); }
+
+   //! Restart the sequence from the given seed
+   void seed(uint64_t value)
+   {
+      // expand the seed with splitmix64 so that similar seeds diverge
+      for(auto& s : state)
+      {
+         value += 0x9E3779B97F4A7C15;
+         uint64_t z = value;
+         z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9;
+         z = (z ^ (z >> 27)) * 0x94D049BB133111EB;
+         s = z ^ (z >> 31);
+      }
+   }
+
+   //! Next 64-bit value
+   uint64_t operator()()
+   {
+      uint64_t result = rotl(state[1] * 5, 7) * 9;
+      uint64_t t      = state[1] << 17;
+
+      state[2] ^= state[0];
+      state[3] ^= state[1];
+      state[1] ^= state[2];
+      state[0] ^= state[3];
+      state[2] ^= t;
+      state[3]  = rotl(state[3], 45);
+
+      return result;
+   }
+
+   //! Uniformly distributed value in the range 0..n-1
+   uint64_t below(uint64_t n)
+   {
+      assert(n > 0);
+
+      // reject the values that would bias the modulo
+      uint64_t threshold = (0 - n) % n;
+
+      for(;;)
+      {
+         uint64_t value = (*this)();
+         if(value >= threshold) return value % n;
+      }
+   }
+
+private:
+   static uint64_t rotl(uint64_t x, unsigned k) { return (x << k) | (x >> (64 - k)); }
+
+   uint64_t state[4];
+};
+
+//! Plots that are guaranteed free of mines when the first hole is dug
+enum SafeZone : uint8_t
+{
+   SAFE_PLOT,         //!< Just the plot dug
+   SAFE_NEIGHBOURHOOD //!< The plot dug and the (up to) eight plots around it
+};
+
+//! Row major indices of the plots in a safe zone in ascending order, returns the count
+inline unsigned getSafeZone(SafeZone zone, unsigned x, unsigned y, unsigned width,
+                            unsigned height, uint64_t index[9])
+{
+   if(zone == SAFE_PLOT)
+   {
+      index[0] = uint64_t(y) * width + x;
+      return 1;
+   }
+
+   unsigned n = 0;
+
+   for(signed scan_y = signed(y) - 1; scan_y <= signed(y) + 1; ++scan_y)
+   {
+      for(signed scan_x = signed(x) - 1; scan_x <= signed(x) + 1; ++scan_x)
+      {
+         if((scan_x >= 0) && (scan_x < signed(width)) && (scan_y >= 0) && (scan_y < signed(height)))
+         {
+            index[n++] = uint64_t(scan_y) * width + scan_x;
+         }
+      }
+   }
+
+   return n;
+}
+
+//! Plant mines in exactly number_of_mines distinct plots chosen uniformly at random
+//
+//  Plots are identified by row major index, none of the sorted excluded plots
+//  are chosen. Uses Floyd's sampling so the cost is O(number_of_mines) whatever
+//  the density, with isMined(index) standing in for the set of plots chosen so
+//  far, so the field must have no mines on entry
+template <typename IS_MINED, typename PLANT>
+void plantMines(Random&         random,
+                uint64_t        number_of_plots,
+                uint64_t        number_of_mines,
+                const uint64_t* excluded,
+                unsigned        number_excluded,
+                IS_MINED        isMined,
+                PLANT           plant)
+{
+   uint64_t candidates = number_of_plots - number_excluded;
+
+   assert(number_of_mines <= candidates);
+
+   // map a candidate number to a plot index by stepping over the excluded plots
+   auto toIndex = [&](uint64_t candidate)
+   {
+      for(unsigned i = 0; i < number_excluded; ++i)
+      {
+         if(candidate >= excluded[i]) ++candidate;
+      }
+      return candidate;
+   };
+
+   for(uint64_t j = candidates - number_of_mines; j < candidates; ++j)
+   {
+      uint64_t index = toIndex(random.below(j + 1));
+
+      if(isMined(index))
+      {
+         index = toIndex(j);
+      }
+
+      plant(index);
+   }
+}
+
+} // namespace MineSweeper
@@ -0,0 +1,785 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 John D. Haughton
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//------------------------------------------------------------------------------
+
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "MineSweeperGame.h"
+
+#if !defined(MSG_NOSIGNAL)
+#define MSG_NOSIGNAL 0
+#endif
+
+namespace MineSweeper {
+
+//! Compact binary protocol spoken by the game server
+//
+//  A client sends fixed size requests and receives a fixed size response to
+//  each, in the same order. A STATE response is followed by the visible
+//  board, one nibble per plot in row order, low nibble first. Multi-byte
+//  fields are little endian
+namespace Protocol {
+
+static const unsigned REQUEST_SIZE  = 12;
+static const unsigned RESPONSE_SIZE = 8;
+
+enum Op : uint8_t
+{
+   NEW   = 1, //!< Start a game at a level with a seed, returns the new session
+   DIG   = 2,
+   FLAG  = 3, //!< Plant or unplant a flag
+   STATE = 4, //!< Return the visible board
+   CLOSE = 5  //!< End a session
+};
+
+enum Status : uint8_t
+{
+   OK          = 0,
+   BAD_REQUEST = 1, //!< Unknown op or level, or a plot off the board
+   NO_SESSION  = 2, //!< No such session on the shard serving this connection
+   FULL        = 3  //!< The shard cannot hold another session
+};
+
+//! Visible plot codes in a STATE response, a hole gives its adjacent mine count
+static const uint8_t CODE_UNDUG     = MineSweeper::CODE_UNDUG;
+static const uint8_t CODE_FLAG      = MineSweeper::CODE_FLAG;
+static const uint8_t CODE_MINE      = MineSweeper::CODE_MINE;
+static const uint8_t CODE_EXPLOSION = MineSweeper::CODE_EXPLOSION;
+
+//! Board size and mines for each level, as in the GUI
+struct Level
+{
+   uint8_t  width;
+   uint8_t  height;
+   uint16_t mines;
+};
+
+static const unsigned NUM_LEVELS = 3;
+
+inline bool isValidLevel(unsigned level) { return (level >= 1) && (level <= NUM_LEVELS); }
+
+inline const Level& getLevel(unsigned level)
+{
+   static const Level table[NUM_LEVELS + 1] = {{0, 0, 0}, {9, 9, 10}, {16, 16, 40}, {30, 16, 99}};
+   return table[level];
+}
+
+//! Size of the board that follows a STATE response
+inline unsigned getBoardBytes(unsigned level)
+{
+   return (getLevel(level).width * getLevel(level).height + 1) / 2;
+}
+
+inline void put16(uint8_t* buffer, uint16_t value)
+{
+   buffer[0] = uint8_t(value);
+   buffer[1] = uint8_t(value >> 8);
+}
+
+inline void put32(uint8_t* buffer, uint32_t value)
+{
+   put16(buffer, uint16_t(value));
+   put16(buffer + 2, uint16_t(value >> 16));
+}
+
+inline uint16_t get16(const uint8_t* buffer)
+{
+   return uint16_t(buffer[0] | (buffer[1] << 8));
+}
+
+inline uint32_t get32(const uint8_t* buffer)
+{
+   return get16(buffer) | (uint32_t(get16(buffer + 2)) << 16);
+}
+
+struct Request
+{
+   uint8_t  op{0};
+   uint8_t  level{0};   //!< NEW only
+   uint8_t  x{0};
+   uint8_t  y{0};
+   uint32_t session{0};
+   uint32_t seed{0};    //!< NEW only
+
+   void encode(uint8_t* buffer) const
+   {
+      buffer[0] = op;
+      buffer[1] = level;
+      buffer[2] = x;
+      buffer[3] = y;
+      put32(buffer + 4, session);
+      put32(buffer + 8, seed);
+   }
+
+   void decode(const uint8_t* buffer)
+   {
+      op      = buffer[0];
+      level   = buffer[1];
+      x       = buffer[2];
+      y       = buffer[3];
+      session = get32(buffer + 4);
+      seed    = get32(buffer + 8);
+   }
+};
+
+struct Response
+{
+   uint8_t  status{OK};
+   uint8_t  progress{RESET};
+   uint16_t flags{0};    //!< Flags left to plant
+   uint32_t session{0};
+
+   void encode(uint8_t* buffer) const
+   {
+      buffer[0] = status;
+      buffer[1] = progress;
+      put16(buffer + 2, flags);
+      put32(buffer + 4, session);
+   }
+
+   void decode(const uint8_t* buffer)
+   {
+      status   = buffer[0];
+      progress = buffer[1];
+      flags    = get16(buffer + 2);
+      session  = get32(buffer + 4);
+   }
+};
+
+} // namespace Protocol
+
+//! Games that are constructed once, in contiguous chunks, and reused
+template <typename GAME>
+class GamePool
+{
+public:
+   GamePool(unsigned number_of_mines_)
+      : number_of_mines(number_of_mines_)
+   {
+   }
+
+   ~GamePool()
+   {
+      for(auto& chunk : chunks)
+      {
+         for(unsigned i = 0; i < CHUNK_SIZE; ++i) get(chunk, i)->~GAME();
+      }
+   }
+
+   //! Get a game, its state is whatever it was left in
+   GAME* allocate()
+   {
+      if(free_list.empty()) grow();
+
+      GAME* game = free_list.back();
+      free_list.pop_back();
+      return game;
+   }
+
+   //! Return a game to the pool
+   void release(GAME* game) { free_list.push_back(game); }
+
+   //! Number of games constructed
+   size_t getCapacity() const { return chunks.size() * CHUNK_SIZE; }
+
+private:
+   static const unsigned CHUNK_SIZE = 64;
+
+   struct alignas(GAME) Storage
+   {
+      uint8_t bytes[sizeof(GAME)];
+   };
+
+   static GAME* get(std::unique_ptr<Storage[]>& chunk, unsigned i)
+   {
+      return reinterpret_cast<GAME*>(&chunk[i]);
+   }
+
+   void grow()
+   {
+      chunks.emplace_back(new Storage[CHUNK_SIZE]);
+
+      for(unsigned i = CHUNK_SIZE; i-- > 0;)
+      {
+         free_list.push_back(new (&chunks.back()[i]) GAME(number_of_mines));
+      }
+   }
+
+   unsigned                                 number_of_mines;
+   std::vector<std::unique_ptr<Storage[]>> chunks;
+   std::vector<GAME*>                       free_list;
+};
+
+//! Sessions served by one thread
+//
+//  A shard owns its sessions, game pools and connections outright so that
+//  nothing is shared with other shards. A session id holds, from the low
+//  bits up, the shard index, the slot of the session and a generation that
+//  changes each time the slot is reused. A request sent down a connection
+//  served by another shard, or holding the id of a closed session, is
+//  refused rather than looked up in the wrong table or applied to a newer
+//  session. Ids are predictable, not secret; what keeps one client out of
+//  another's games is that a session only answers the connection that
+//  opened it, and is closed when that connection closes
+class Shard
+{
+public:
+   static const unsigned SHARD_BITS      = 8;
+   static const unsigned SLOT_BITS       = 16;
+   static const unsigned GENERATION_BITS = 32 - SHARD_BITS - SLOT_BITS;
+   static const unsigned MAX_SHARDS      = 1 << SHARD_BITS;
+   static const uint32_t MAX_SESSIONS    = 1 << SLOT_BITS;
+
+   Shard(unsigned index_ = 0, uint32_t max_sessions_ = MAX_SESSIONS)
+      : index(index_)
+      , max_sessions(std::min(max_sessions_, uint32_t(MAX_SESSIONS)))
+   {
+   }
+
+   Shard(const Shard&) = delete;
+
+   //! Number of sessions open
+   uint32_t getNumberOfSessions() const { return number_of_sessions; }
+
+   //! Most sessions that can be open at once
+   uint32_t getMaxSessions() const { return max_sessions; }
+
+   //! Handle one request from the given connection, appending the response to out
+   void handle(const uint8_t* buffer, std::vector<uint8_t>& out, uint32_t owner = 0)
+   {
+      Protocol::Request request;
+      request.decode(buffer);
+
+      Protocol::Response response;
+      response.session = request.session;
+
+      size_t at = out.size();
+      out.resize(at + Protocol::RESPONSE_SIZE);
+
+      Session* session = nullptr;
+
+      if(request.op == Protocol::NEW)
+      {
+         if(!Protocol::isValidLevel(request.level))
+         {
+            response.status = Protocol::BAD_REQUEST;
+         }
+         else if(number_of_sessions == max_sessions)
+         {
+            response.status = Protocol::FULL;
+         }
+         else
+         {
+            response.session = open(request.level, owner);
+            session          = find(response.session, owner);
+            visit(*session, [&](auto& game){ game.reset(request.seed); });
+         }
+      }
+      else if((session = find(request.session, owner)) == nullptr)
+      {
+         response.status = Protocol::NO_SESSION;
+      }
+      else if(request.op == Protocol::CLOSE)
+      {
+         close(*session);
+         session = nullptr;
+      }
+      else if(request.op == Protocol::STATE)
+      {
+         visit(*session, [&](auto& game){ appendBoard(game, out); });
+      }
+      else if((request.op == Protocol::DIG) || (request.op == Protocol::FLAG))
+      {
+         const Protocol::Level& level = Protocol::getLevel(session->level);
+
+         if((request.x >= level.width) || (request.y >= level.height))
+         {
+            response.status = Protocol::BAD_REQUEST;
+         }
+         else if(request.op == Protocol::DIG)
+         {
+            visit(*session, [&](auto& game){ game.digHole(request.x, request.y); });
+         }
+         else
+         {
+            visit(*session, [&](auto& game){ game.plantUnplantFlag(request.x, request.y); });
+         }
+      }
+      else
+      {
+         response.status = Protocol::BAD_REQUEST;
+      }
+
+      if(session != nullptr)
+      {
+         visit(*session, [&](auto& game)
+         {
+            response.progress = game.getProgress();
+            response.flags    = uint16_t(game.getNumberOfFlags());
+         });
+      }
+
+      response.encode(&out[at]);
+   }
+
+   //! Handle every whole request in a buffer, returns the number of bytes used
+   size_t handleAll(const uint8_t* buffer, size_t size, std::vector<uint8_t>& out, uint32_t owner = 0)
+   {
+      size_t used = 0;
+
+      for(; (size - used) >= Protocol::REQUEST_SIZE; used += Protocol::REQUEST_SIZE)
+      {
+         handle(buffer + used, out, owner);
+      }
+
+      return used;
+   }
+
+   //! Serve a single blocking stream, such as stdin and stdout, until it closes
+   bool serveStream(int in_fd, int out_fd)
+   {
+      std::vector<uint8_t> in(READ_SIZE);
+      std::vector<uint8_t> out;
+      size_t               pending = 0;
+
+      for(;;)
+      {
+         ssize_t n = ::read(in_fd, &in[pending], in.size() - pending);
+         if(n < 0 && errno == EINTR) continue;
+         if(n <= 0) return n == 0;
+
+         pending += n;
+
+         out.clear();
+         size_t used = handleAll(in.data(), pending, out);
+         std::memmove(in.data(), &in[used], pending - used);
+         pending -= used;
+
+         for(size_t sent = 0; sent < out.size();)
+         {
+            ssize_t m = ::write(out_fd, &out[sent], out.size() - sent);
+            if(m < 0 && errno == EINTR) continue;
+            if(m <= 0) return false;
+            sent += m;
+         }
+      }
+   }
+
+   //! Accept connections from a shared non-blocking listening socket and serve them until stop is set
+   //
+   //  Every shard polls the same listening socket, the kernel hands each new
+   //  connection to whichever shard accepts it first and the losers see
+   //  EAGAIN. A connection then stays with that shard for its lifetime
+   void run(int listen_fd, const std::atomic<bool>& stop)
+   {
+      std::vector<pollfd> fds;
+
+      while(!stop.load(std::memory_order_relaxed))
+      {
+         fds.clear();
+         fds.push_back({listen_fd, POLLIN, 0});
+
+         for(Connection& connection : connections)
+         {
+            short events = 0;
+            if(connection.out.size() < MAX_BUFFERED) events |= POLLIN;
+            if(connection.sent < connection.out.size()) events |= POLLOUT;
+            fds.push_back({connection.fd, events, 0});
+         }
+
+         if(::poll(fds.data(), fds.size(), POLL_MS) <= 0) continue;
+
+         for(size_t i = 1; i < fds.size(); ++i)
+         {
+            Connection& connection = connections[i - 1];
+
+            if(fds[i].revents & (POLLIN | POLLHUP | POLLERR)) receive(connection);
+            if((connection.fd >= 0) && (fds[i].revents & POLLOUT)) transmit(connection);
+         }
+
+         if(fds[0].revents & POLLIN) accept(listen_fd);
+
+         for(size_t i = connections.size(); i-- > 0;)
+         {
+            if(connections[i].fd < 0)
+            {
+               closeSessions(connections[i].id);
+               connections[i] = std::move(connections.back());
+               connections.pop_back();
+            }
+         }
+      }
+
+      for(Connection& connection : connections)
+      {
+         ::close(connection.fd);
+         closeSessions(connection.id);
+      }
+
+      connections.clear();
+   }
+
+private:
+   static const size_t   READ_SIZE    = 64 * 1024;
+   static const size_t   MAX_BUFFERED = 1024 * 1024; //!< Stop reading while this much output is waiting
+   static const int      POLL_MS      = 50;
+
+   static const uint32_t SLOT_MASK       = MAX_SESSIONS - 1;
+   static const uint32_t GENERATION_MASK = (1 << GENERATION_BITS) - 1;
+
+   struct Session
+   {
+      uint8_t  level{0};          //!< 0 for a free slot
+      uint8_t  generation{0};     //!< Never 0 so that id 0 is never valid
+      uint32_t owner{0};          //!< Connection that opened the session
+      void*    game{nullptr};
+   };
+
+   struct Connection
+   {
+      uint32_t             id{0};
+      int                  fd{-1};
+      std::vector<uint8_t> in;
+      size_t               pending{0};  //!< Bytes of a partial request at the start of in
+      std::vector<uint8_t> out;
+      size_t               sent{0};
+   };
+
+   //! Call fn with the session's game as its real type
+   template <typename FN>
+   void visit(Session& session, FN fn)
+   {
+      switch(session.level)
+      {
+      case 1: fn(*static_cast<Game<9, 9>*>(session.game));   break;
+      case 2: fn(*static_cast<Game<16, 16>*>(session.game)); break;
+      case 3: fn(*static_cast<Game<30, 16>*>(session.game)); break;
+      }
+   }
+
+   Session* find(uint32_t id, uint32_t owner)
+   {
+      uint32_t slot       = (id >> SHARD_BITS) & SLOT_MASK;
+      uint32_t generation = id >> (SHARD_BITS + SLOT_BITS);
+
+      if(((id & (MAX_SHARDS - 1)) != index) || (slot >= sessions.size())) return nullptr;
+
+      Session& session = sessions[slot];
+
+      if((session.level == 0) || (session.generation != generation) || (session.owner != owner))
+      {
+         return nullptr;
+      }
+
+      return &session;
+   }
+
+   uint32_t open(uint8_t level, uint32_t owner)
+   {
+      uint32_t slot;
+
+      if(free_slots.empty())
+      {
+         slot = uint32_t(sessions.size());
+         sessions.emplace_back();
+      }
+      else
+      {
+         slot = free_slots.back();
+         free_slots.pop_back();
+      }
+
+      Session& session  = sessions[slot];
+      session.level      = level;
+      session.owner      = owner;
+      session.generation = uint8_t(session.generation % GENERATION_MASK + 1);
+
+      switch(level)
+      {
+      case 1: session.game = pool_beginner.allocate();     break;
+      case 2: session.game = pool_intermediate.allocate(); break;
+      case 3: session.game = pool_expert.allocate();       break;
+      }
+
+      ++number_of_sessions;
+
+      return (uint32_t(session.generation) << (SHARD_BITS + SLOT_BITS)) | (slot << SHARD_BITS) | index;
+   }
+
+   void release(Session& session)
+   {
+      switch(session.level)
+      {
+      case 1: pool_beginner.release(static_cast<Game<9, 9>*>(session.game));       break;
+      case 2: pool_intermediate.release(static_cast<Game<16, 16>*>(session.game)); break;
+      case 3: pool_expert.release(static_cast<Game<30, 16>*>(session.game));       break;
+      }
+   }
+
+   void close(Session& session)
+   {
+      release(session);
+
+      free_slots.push_back(uint32_t(&session - sessions.data()));
+
+      // keep the generation so that the next session in this slot gets a new id
+      session.level = 0;
+      session.owner = 0;
+      session.game  = nullptr;
+
+      --number_of_sessions;
+   }
+
+   //! Close every session opened by a connection that has gone
+   void closeSessions(uint32_t owner)
+   {
+      for(Session& session : sessions)
+      {
+         if((session.level != 0) && (session.owner == owner)) close(session);
+      }
+   }
+
+   template <typename GAME>
+   static void appendBoard(const GAME& game, std::vector<uint8_t>& out)
+   {
+      size_t at = out.size();
+      out.resize(at + (GAME::getWidth() * GAME::getHeight() + 1) / 2, 0);
+
+      unsigned i = 0;
+
+      for(unsigned y = 0; y < GAME::getHeight(); ++y)
+      {
+         for(unsigned x = 0; x < GAME::getWidth(); ++x, ++i)
+         {
+            out[at + i / 2] |= game.getVisibleCode(x, y) << ((i & 1) * 4);
+         }
+      }
+   }
+
+   void accept(int listen_fd)
+   {
+      for(;;)
+      {
+         int fd = ::accept(listen_fd, nullptr, nullptr);
+         if(fd < 0) return;
+
+         ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK);
+
+         if(++last_connection_id == 0) ++last_connection_id;
+
+         connections.emplace_back();
+         connections.back().id = last_connection_id;
+         connections.back().fd = fd;
+         connections.back().in.resize(READ_SIZE);
+      }
+   }
+
+   void receive(Connection& connection)
+   {
+      ssize_t n = ::read(connection.fd, &connection.in[connection.pending],
+                         connection.in.size() - connection.pending);
+
+      if(n < 0 && (errno == EAGAIN || errno == EINTR)) return;
+
+      if(n <= 0)
+      {
+         ::close(connection.fd);
+         connection.fd = -1;
+         return;
+      }
+
+      connection.pending += n;
+
+      if(connection.sent == connection.out.size())
+      {
+         connection.out.clear();
+         connection.sent = 0;
+      }
+
+      size_t used = handleAll(connection.in.data(), connection.pending, connection.out, connection.id);
+      std::memmove(connection.in.data(), &connection.in[used], connection.pending - used);
+      connection.pending -= used;
+
+      transmit(connection);
+   }
+
+   void transmit(Connection& connection)
+   {
+      while(connection.sent < connection.out.size())
+      {
+         ssize_t n = ::send(connection.fd, &connection.out[connection.sent],
+                            connection.out.size() - connection.sent, MSG_NOSIGNAL);
+
+         if(n < 0 && errno == EINTR) continue;
+         if(n < 0 && errno == EAGAIN) return;
+
+         if(n <= 0)
+         {
+            ::close(connection.fd);
+            connection.fd = -1;
+            return;
+         }
+
+         connection.sent += n;
+      }
+   }
+
+   unsigned                 index;
+   uint32_t                 max_sessions;
+   uint32_t                 number_of_sessions{0};
+   std::vector<Session>     sessions;
+   std::vector<uint32_t>    free_slots;
+   GamePool<Game<9, 9>>     pool_beginner{Protocol::getLevel(1).mines};
+   GamePool<Game<16, 16>>   pool_intermediate{Protocol::getLevel(2).mines};
+   GamePool<Game<30, 16>>   pool_expert{Protocol::getLevel(3).mines};
+   std::vector<Connection>  connections;
+   uint32_t                 last_connection_id{0};  //!< 0 is the stream served by serveStream()
+};
+
+//! Game server with one shard per core, listening on a Unix domain socket
+class Server
+{
+public:
+   Server(unsigned number_of_shards_ = 0, uint32_t max_sessions_per_shard = Shard::MAX_SESSIONS)
+      : number_of_shards(number_of_shards_)
+   {
+      if(number_of_shards == 0)
+      {
+         number_of_shards = std::max(1u, std::thread::hardware_concurrency());
+      }
+
+      number_of_shards = std::min(number_of_shards, unsigned(Shard::MAX_SHARDS));
+
+      for(unsigned i = 0; i < number_of_shards; ++i)
+      {
+         shards.emplace_back(new Shard(i, max_sessions_per_shard));
+      }
+   }
+
+   ~Server()
+   {
+      if(listen_fd >= 0)
+      {
+         ::close(listen_fd);
+         ::unlink(path.c_str());
+      }
+   }
+
+   //! Number of shards, each served by its own thread
+   unsigned getNumberOfShards() const { return number_of_shards; }
+
+   //! Create the listening socket, replacing any stale socket at the path
+   bool listen(const char* path_)
+   {
+      sockaddr_un addr{};
+      addr.sun_family = AF_UNIX;
+
+      if(std::strlen(path_) >= sizeof(addr.sun_path)) return false;
+
+      std::strcpy(addr.sun_path, path_);
+
+      listen_fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+      if(listen_fd < 0) return false;
+
+      ::unlink(path_);
+
+      if((::bind(listen_fd, (const sockaddr*)&addr, sizeof(addr)) != 0) ||
+         (::listen(listen_fd, SOMAXCONN) != 0))
+      {
+         ::close(listen_fd);
+         listen_fd = -1;
+         return false;
+      }
+
+      ::fcntl(listen_fd, F_SETFL, ::fcntl(listen_fd, F_GETFL) | O_NONBLOCK);
+
+      path = path_;
+      return true;
+   }
+
+   //! Serve until stop() is called
+   void run()
+   {
+      std::vector<std::thread> threads;
+
+      for(unsigned i = 0; i < number_of_shards; ++i)
+      {
+         threads.emplace_back([this, i]{ shards[i]->run(listen_fd, stopping); });
+         pin(threads.back(), i);
+      }
+
+      for(std::thread& thread : threads) thread.join();
+   }
+
+   //! Ask run() to return, safe to call from any thread
+   void stop() { stopping.store(true, std::memory_order_relaxed); }
+
+   //! Serve a single stream with the first shard
+   bool serveStream(int in_fd, int out_fd) { return shards[0]->serveStream(in_fd, out_fd); }
+
+private:
+   //! Keep a shard on one core so that its sessions stay in that core's caches
+   static void pin(std::thread& thread, unsigned shard)
+   {
+#if defined(__linux__)
+      unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+
+      cpu_set_t cpus;
+      CPU_ZERO(&cpus);
+      CPU_SET(shard % cores, &cpus);
+      pthread_setaffinity_np(thread.native_handle(), sizeof(cpus), &cpus);
+#else
+      (void)thread;
+      (void)shard;
+#endif
+   }
+
+   unsigned                            number_of_shards;
+   std::vector<std::unique_ptr<Shard>> shards;
+   int                                 listen_fd{-1};
+   std::string                         path;
+   std::atomic<bool>                   stopping{false};
+};
+
+} // namespace MineSweeper
@@ -0,0 +1,319 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 John D. Haughton
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//------------------------------------------------------------------------------
+
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "MineSweeperGame.h"
+#include "MineSweeperPlayer.h"
+
+namespace MineSweeper {
+
+//! Log scale histogram of durations, with eight buckets per power of two
+class Histogram
+{
+public:
+   //! Record a duration
+   void add(uint64_t ns)
+   {
+      ++count[bucket(ns)];
+      ++total;
+   }
+
+   //! Add all the samples from another histogram
+   void merge(const Histogram& other)
+   {
+      for(unsigned i = 0; i < count.size(); ++i) count[i] += other.count[i];
+      total += other.total;
+   }
+
+   //! Upper bound of the bucket holding the p'th percentile (0..100)
+   uint64_t getPercentile(double p) const
+   {
+      uint64_t target = uint64_t(total * p / 100.0);
+      uint64_t seen   = 0;
+
+      for(unsigned i = 0; i < count.size(); ++i)
+      {
+         seen += count[i];
+         if((seen > target) && (seen > 0)) return upperBound(i);
+      }
+
+      return 0;
+   }
+
+private:
+   static const unsigned SUB_BITS = 3;
+
+   static unsigned bucket(uint64_t ns)
+   {
+      if(ns < (1 << SUB_BITS)) return unsigned(ns);
+
+      unsigned msb = 63 - __builtin_clzll(ns);
+      unsigned sub = unsigned(ns >> (msb - SUB_BITS)) & ((1 << SUB_BITS) - 1);
+
+      return ((msb - SUB_BITS + 1) << SUB_BITS) + sub;
+   }
+
+   static uint64_t upperBound(unsigned index)
+   {
+      if(index < (1 << SUB_BITS)) return index;
+
+      unsigned msb = (index >> SUB_BITS) + SUB_BITS - 1;
+      uint64_t sub = index & ((1 << SUB_BITS) - 1);
+
+      return ((uint64_t((1 << SUB_BITS) + sub + 1)) << (msb - SUB_BITS)) - 1;
+   }
+
+   std::array<uint64_t, (64 - SUB_BITS + 1) << SUB_BITS> count{};
+   uint64_t total{0};
+};
+
+//! Totals for a batch of simulated games
+struct SimulationResult
+{
+   uint64_t  games{0};
+   uint64_t  wins{0};
+   uint64_t  stalls{0};          //!< Games abandoned when the player stopped making progress
+   uint64_t  revealed_plots{0};  //!< Total of the safe plots dug at the end of each game
+   double    seconds{0.0};       //!< Wall clock time for the batch
+   Histogram game_time;          //!< Time to play each game (ns)
+
+   void merge(const SimulationResult& other)
+   {
+      games          += other.games;
+      wins           += other.wins;
+      stalls         += other.stalls;
+      revealed_plots += other.revealed_plots;
+      game_time.merge(other.game_time);
+   }
+
+   double getWinRate() const { return games == 0 ? 0.0 : double(wins) / games; }
+
+   double getGamesPerSecond() const { return seconds == 0.0 ? 0.0 : games / seconds; }
+
+   double getAverageRevealed() const { return games == 0 ? 0.0 : double(revealed_plots) / games; }
+};
+
+//! Play many games on all cores with an automatic player
+//
+//  Each worker thread owns its own game and player instances. The game
+//  numbers are split between the workers up front and a worker that runs
+//  out steals half of the remaining games from another worker. Game n is
+//  always played from seed + n so results do not depend on the number of
+//  threads or on scheduling
+template <typename GAME>
+class Simulator
+{
+public:
+   using GameFactory   = std::function<std::unique_ptr<GAME>()>;
+   using PlayerFactory = std::function<std::unique_ptr<Player<GAME>>()>;
+
+   Simulator(GameFactory new_game_, PlayerFactory new_player_, unsigned number_of_threads_ = 0)
+      : new_game(new_game_)
+      , new_player(new_player_)
+      , number_of_threads(number_of_threads_)
+   {
+      if(number_of_threads == 0)
+      {
+         number_of_threads = std::max(1u, std::thread::hardware_concurrency());
+      }
+   }
+
+   //! Number of worker threads used
+   unsigned getNumberOfThreads() const { return number_of_threads; }
+
+   //! Play the given number of games
+   SimulationResult run(uint64_t number_of_games, uint64_t seed)
+   {
+      std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+      queue.reset(new Queue[number_of_threads]);
+
+      for(unsigned i = 0; i < number_of_threads; ++i)
+      {
+         queue[i].begin = number_of_games * i / number_of_threads;
+         queue[i].end   = number_of_games * (i + 1) / number_of_threads;
+      }
+
+      std::vector<SimulationResult> result(number_of_threads);
+      std::vector<std::thread>      thread;
+
+      for(unsigned i = 0; i < number_of_threads; ++i)
+      {
+         thread.emplace_back([this, i, seed, &result]{ work(i, seed, result[i]); });
+      }
+
+      SimulationResult total;
+
+      for(unsigned i = 0; i < number_of_threads; ++i)
+      {
+         thread[i].join();
+         total.merge(result[i]);
+      }
+
+      total.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+      return total;
+   }
+
+   //! Play a single game to completion, returns false if the player stalled
+   static bool play(GAME& game, Player<GAME>& player, uint64_t seed)
+   {
+      game.reset(seed);
+      player.start(seed);
+
+      // A move that changes nothing is a player bug, give up rather than hang
+      uint64_t max_moves = uint64_t(game.getWidth()) * game.getHeight() * 2;
+
+      for(uint64_t moves = 0; moves < max_moves; ++moves)
+      {
+         Progress progress = game.getProgress();
+
+         if((progress == DETONATED) || (progress == CLEARED)) return true;
+
+         player.move(game);
+      }
+
+      return false;
+   }
+
+private:
+   //! Range of game numbers still to be played by one worker
+   struct alignas(64) Queue
+   {
+      std::mutex mutex;
+      uint64_t   begin{0};
+      uint64_t   end{0};
+   };
+
+   static const uint64_t CHUNK = 64;
+
+   //! Take a chunk of games from this worker's queue or steal from another
+   bool takeWork(unsigned id, uint64_t& begin, uint64_t& end)
+   {
+      {
+         Queue& own = queue[id];
+         std::lock_guard<std::mutex> lock(own.mutex);
+
+         if(own.begin < own.end)
+         {
+            begin     = own.begin;
+            end       = std::min(own.end, begin + CHUNK);
+            own.begin = end;
+            return true;
+         }
+      }
+
+      for(unsigned i = 1; i < number_of_threads; ++i)
+      {
+         Queue& victim = queue[(id + i) % number_of_threads];
+
+         {
+            std::lock_guard<std::mutex> lock(victim.mutex);
+
+            if(victim.begin == victim.end) continue;
+
+            // steal the back half
+            end        = victim.end;
+            begin      = victim.end - (victim.end - victim.begin + 1) / 2;
+            victim.end = begin;
+         }
+
+         if((end - begin) > CHUNK)
+         {
+            // keep a chunk and queue the rest as our own
+            Queue& own = queue[id];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            own.begin = begin + CHUNK;
+            own.end   = end;
+            end       = own.begin;
+         }
+
+         return true;
+      }
+
+      return false;
+   }
+
+   void work(unsigned id, uint64_t seed, SimulationResult& result)
+   {
+      std::unique_ptr<GAME>         game   = new_game();
+      std::unique_ptr<Player<GAME>> player = new_player();
+
+      uint64_t begin, end;
+
+      while(takeWork(id, begin, end))
+      {
+         for(uint64_t n = begin; n < end; ++n)
+         {
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+            bool finished = play(*game, *player, seed + n);
+
+            std::chrono::steady_clock::time_point stop = std::chrono::steady_clock::now();
+
+            result.game_time.add(std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count());
+
+            ++result.games;
+
+            if(!finished)                           ++result.stalls;
+            if(game->getProgress() == CLEARED)      ++result.wins;
+
+            result.revealed_plots += countRevealed(*game);
+         }
+      }
+   }
+
+   static uint64_t countRevealed(const GAME& game)
+   {
+      uint64_t revealed = 0;
+
+      for(unsigned y = 0; y < game.getHeight(); ++y)
+      {
+         for(unsigned x = 0; x < game.getWidth(); ++x)
+         {
+            bool mine;
+            if((game.getPlotState(x, y, mine) == HOLE) && !mine) ++revealed;
+         }
+      }
+
+      return revealed;
+   }
+
+   GameFactory                new_game;
+   PlayerFactory              new_player;
+   unsigned                   number_of_threads;
+   std::unique_ptr<Queue[]>   queue;
+};
+
+} // namespace MineSweeper
@@ -0,0 +1,424 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 John D. Haughton
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//------------------------------------------------------------------------------
+
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "MineSweeperAdjacency.h"
+#include "MineSweeperBitBoard.h"
+#include "MineSweeperGame.h"
+#include "MineSweeperPlayer.h"
+#include "MineSweeperProbability.h"
+
+namespace MineSweeper {
+
+//! Deterministic solver working only from the visible state of a game
+//
+//  Every numbered hole with undug neighbours is a constraint, a 3x3 bit mask
+//  of the undug plots around it and the number of mines they must hold.
+//  Single constraints and pairs of constraints where one mask is a subset of
+//  the other are used to find plots that are certainly safe or certainly
+//  mined. Flags are trusted to be on mines
+template <unsigned WIDTH, unsigned HEIGHT>
+class Solver
+{
+public:
+   using Board = BitBoard<WIDTH, HEIGHT>;
+
+   Solver()
+      : flag_counts(WIDTH * HEIGHT)
+      , constraint_at(WIDTH * HEIGHT, uint32_t(NONE))
+   {
+   }
+
+   //! Find the plots that are certainly safe or mined, returns true if there are any
+   template <typename GAME>
+   bool solve(const GAME& game)
+   {
+      read(game);
+
+      safe.clearAll();
+      mined.clearAll();
+
+      for(bool found = true; found;)
+      {
+         update();
+         found = applySingleRules() || applySubsetRules();
+      }
+
+      return safe.any() || mined.any();
+   }
+
+   //! Plots found to be safe by the last solve()
+   const Board& getSafe() const { return safe; }
+
+   //! Plots found to be mined by the last solve()
+   const Board& getMines() const { return mined; }
+
+   //! Dig every safe plot and flag every mined plot found by the last solve()
+   template <typename GAME>
+   void apply(GAME& game) const
+   {
+      safe.forEach([&](unsigned x, unsigned y) { game.digHole(x, y); });
+
+      mined.forEach([&](unsigned x, unsigned y)
+      {
+         bool mine;
+         if(game.getPlotState(x, y, mine) == UNDUG) game.plantUnplantFlag(x, y);
+      });
+   }
+
+   //! Apply the last solve() to the reference engine as a single batch
+   void apply(Game<WIDTH, HEIGHT>& game) const
+   {
+      moves.clear();
+
+      safe.forEach([&](unsigned x, unsigned y)
+      {
+         moves.push_back({uint16_t(x), uint16_t(y), Move::DIG});
+      });
+
+      mined.forEach([&](unsigned x, unsigned y)
+      {
+         bool mine;
+         if(game.getPlotState(x, y, mine) == UNDUG)
+         {
+            moves.push_back({uint16_t(x), uint16_t(y), Move::FLAG});
+         }
+      });
+
+      game.applyMoves(moves.data(), moves.size());
+   }
+
+   //! Solve and apply until nothing more can be deduced, returns the number of rounds
+   template <typename GAME>
+   unsigned play(GAME& game)
+   {
+      unsigned rounds = 0;
+
+      while((game.getProgress() == CLEARING) && solve(game))
+      {
+         apply(game);
+         ++rounds;
+      }
+
+      return rounds;
+   }
+
+private:
+   //! Undug plots around a numbered hole
+   struct Constraint
+   {
+      uint16_t x;
+      uint16_t y;
+      uint16_t mask;   //!< bit (dx + 1) + 3 * (dy + 1) for the plot at (x + dx, y + dy)
+      uint8_t  mines;  //!< Number of mines still to be found in the mask
+   };
+
+   static const uint32_t NONE = ~uint32_t(0);
+
+   //! Build the constraints from the visible state of the game
+   template <typename GAME>
+   void read(const GAME& game)
+   {
+      unknown.clearAll();
+      flagged.clearAll();
+
+      for(auto& c : constraints) constraint_at[c.y * WIDTH + c.x] = NONE;
+      constraints.clear();
+
+      holes.clear();
+
+      for(unsigned y = 0; y < HEIGHT; ++y)
+      {
+         for(unsigned x = 0; x < WIDTH; ++x)
+         {
+            bool mine;
+            switch(game.getPlotState(x, y, mine))
+            {
+            case UNDUG: unknown.set(x, y); break;
+            case FLAG:  flagged.set(x, y); break;
+            case HOLE:  if(!mine) holes.push_back(y * WIDTH + x); break;
+            default: break;
+            }
+         }
+      }
+
+      countAdjacent(flagged, flag_counts.data());
+
+      for(uint32_t index : holes)
+      {
+         unsigned x = index % WIDTH;
+         unsigned y = index / WIDTH;
+
+         uint16_t mask  = unknown.getWindow(x, y);
+         unsigned flags = flag_counts[index];
+         unsigned count = game.getNumberOfAdjacentMines(x, y);
+
+         if((mask == 0) || (flags > count)) continue;
+
+         constraint_at[index] = constraints.size();
+         constraints.push_back({uint16_t(x), uint16_t(y), mask, uint8_t(count - flags)});
+      }
+   }
+
+   //! Remove the plots that have been resolved since the constraints were built
+   void update()
+   {
+      for(auto& c : constraints)
+      {
+         for(uint16_t bits = c.mask; bits != 0; bits &= bits - 1)
+         {
+            unsigned bit = __builtin_ctz(bits);
+            unsigned x   = c.x + bit % 3 - 1;
+            unsigned y   = c.y + bit / 3 - 1;
+
+            if(mined.test(x, y))
+            {
+               c.mask &= ~(1 << bit);
+               --c.mines;
+            }
+            else if(safe.test(x, y))
+            {
+               c.mask &= ~(1 << bit);
+            }
+         }
+      }
+   }
+
+   //! Mark the plots in a mask centred on (x, y), returns true if any were new
+   bool mark(Board& board, unsigned x, unsigned y, uint16_t mask)
+   {
+      bool found = false;
+
+      for(; mask != 0; mask &= mask - 1)
+      {
+         unsigned bit    = __builtin_ctz(mask);
+         unsigned plot_x = x + bit % 3 - 1;
+         unsigned plot_y = y + bit / 3 - 1;
+
+         if(unknown.test(plot_x, plot_y))
+         {
+            unknown.clear(plot_x, plot_y);
+            board.set(plot_x, plot_y);
+            found = true;
+         }
+      }
+
+      return found;
+   }
+
+   //! All-safe and all-mined single constraints
+   bool applySingleRules()
+   {
+      bool found = false;
+
+      for(const auto& c : constraints)
+      {
+         if(c.mask == 0) continue;
+
+         if(c.mines == 0)
+         {
+            found |= mark(safe, c.x, c.y, c.mask);
+         }
+         else if(c.mines == popCount(c.mask))
+         {
+            found |= mark(mined, c.x, c.y, c.mask);
+         }
+      }
+
+      return found;
+   }
+
+   //! Move a 3x3 mask centred at offset (dx, dy) into a 7x7 frame
+   static uint64_t toFrame(uint16_t mask, signed dx, signed dy)
+   {
+      uint64_t frame = 0;
+
+      for(; mask != 0; mask &= mask - 1)
+      {
+         unsigned bit = __builtin_ctz(mask);
+         unsigned u   = bit % 3 + 2 + dx;
+         unsigned v   = bit / 3 + 2 + dy;
+
+         frame |= uint64_t(1) << (u + 7 * v);
+      }
+
+      return frame;
+   }
+
+   //! Mark the plots of a 7x7 frame centred on (x, y)
+   bool markFrame(Board& board, unsigned x, unsigned y, uint64_t frame)
+   {
+      bool found = false;
+
+      for(; frame != 0; frame &= frame - 1)
+      {
+         unsigned bit    = __builtin_ctzll(frame);
+         unsigned plot_x = x + bit % 7 - 3;
+         unsigned plot_y = y + bit / 7 - 3;
+
+         if(unknown.test(plot_x, plot_y))
+         {
+            unknown.clear(plot_x, plot_y);
+            board.set(plot_x, plot_y);
+            found = true;
+         }
+      }
+
+      return found;
+   }
+
+   //! Where constraint A is a subset of constraint B, B - A holds the difference in mines
+   bool applySubsetRules()
+   {
+      bool found = false;
+
+      for(const auto& a : constraints)
+      {
+         if(a.mask == 0) continue;
+
+         uint64_t frame_a = toFrame(a.mask, 0, 0);
+
+         for(signed dy = -2; dy <= 2; ++dy)
+         {
+            for(signed dx = -2; dx <= 2; ++dx)
+            {
+               signed bx = signed(a.x) + dx;
+               signed by = signed(a.y) + dy;
+
+               if(((dx == 0) && (dy == 0)) ||
+                  (bx < 0) || (bx >= signed(WIDTH)) || (by < 0) || (by >= signed(HEIGHT)))
+               {
+                  continue;
+               }
+
+               uint32_t index = constraint_at[by * WIDTH + bx];
+               if(index == NONE) continue;
+
+               const Constraint& b = constraints[index];
+
+               uint64_t frame_b = toFrame(b.mask, dx, dy);
+
+               if((frame_a & ~frame_b) != 0) continue;
+
+               uint64_t diff       = frame_b & ~frame_a;
+               unsigned diff_mines = b.mines - a.mines;
+
+               if(diff == 0) continue;
+
+               if(diff_mines == 0)
+               {
+                  found |= markFrame(safe, a.x, a.y, diff);
+               }
+               else if(diff_mines == popCount(diff))
+               {
+                  found |= markFrame(mined, a.x, a.y, diff);
+               }
+            }
+         }
+      }
+
+      return found;
+   }
+
+   Board                   unknown;  //!< Undug plots that have not been resolved
+   Board                   flagged;
+   Board                   safe;
+   Board                   mined;
+   std::vector<uint8_t>    flag_counts; //!< Flags adjacent to each plot
+   std::vector<uint32_t>   holes;    //!< Numbered holes read from the game
+   std::vector<Constraint> constraints;
+   std::vector<uint32_t>   constraint_at;
+   mutable std::vector<Move> moves;  //!< Batch built by apply()
+};
+
+//! Player that makes every deduction it can and when stuck digs the plot least likely to be mined
+template <typename GAME>
+class SolverPlayer;
+
+template <template <unsigned, unsigned> class ENGINE, unsigned WIDTH, unsigned HEIGHT>
+class SolverPlayer<ENGINE<WIDTH, HEIGHT>> : public Player<ENGINE<WIDTH, HEIGHT>>
+{
+public:
+   using GAME = ENGINE<WIDTH, HEIGHT>;
+
+   const char* getName() const override { return "solver"; }
+
+   void start(uint64_t seed) override { guesser.start(seed); }
+
+   void move(GAME& game) override
+   {
+      if(game.getProgress() == RESET)
+      {
+         // First dig is always safe, start in the middle
+         game.digHole(WIDTH / 2, HEIGHT / 2);
+      }
+      else if(solver.solve(game))
+      {
+         solver.apply(game);
+      }
+      else if(!guessSafest(game))
+      {
+         guesser.move(game);
+      }
+   }
+
+private:
+   bool guessSafest(GAME& game)
+   {
+      if(!probability.solve(game)) return false;
+
+      double   lowest = 1.0;
+      unsigned best_x = 0;
+      unsigned best_y = 0;
+
+      for(unsigned y = 0; y < HEIGHT; ++y)
+      {
+         for(unsigned x = 0; x < WIDTH; ++x)
+         {
+            bool mine;
+            if((game.getPlotState(x, y, mine) == UNDUG) && (probability.getProbability(x, y) < lowest))
+            {
+               lowest = probability.getProbability(x, y);
+               best_x = x;
+               best_y = y;
+            }
+         }
+      }
+
+      // Every undug plot is mined, leave the flagging to the random player
+      if(lowest > (1.0 - 1e-9)) return false;
+
+      game.digHole(best_x, best_y);
+      return true;
+   }
+
+   Solver<WIDTH, HEIGHT>      solver;
+   Probability<WIDTH, HEIGHT> probability;
+   RandomPlayer<GAME>         guesser;
+};
+
+} // namespace MineSweeper
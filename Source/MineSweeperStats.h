@@ -0,0 +1,373 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 John D. Haughton
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//------------------------------------------------------------------------------
+
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+//! Build with MINESWEEPER_STATS=1 to collect the counters, otherwise every call compiles away
+#if !defined(MINESWEEPER_STATS)
+#define MINESWEEPER_STATS 0
+#endif
+
+#if MINESWEEPER_STATS
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace MineSweeper {
+
+//! Process wide instrumentation counters for the engine and GUI
+//
+//  Each thread adds to its own cache line sized slot of relaxed atomics so
+//  counting never contends between threads, readers sum the slots. Reading
+//  and writing JSON allocate nothing so can be done from a signal handler
+namespace Stats {
+
+static const bool ENABLED = MINESWEEPER_STATS != 0;
+
+enum CounterId : unsigned
+{
+   DIGS,             //!< Digs of an undug plot
+   CELLS_REVEALED,   //!< Plots dug, including by flood fill
+   FLOOD_MAX_DEPTH,  //!< Most plots waiting on the flood fill stack at once
+   REPLANTS,         //!< First digs that re-planted to clear the safe zone
+   RESETS,           //!< Games reset
+   NUM_COUNTERS
+};
+
+enum TimerId : unsigned
+{
+   APP_EVENT,  //!< MineSweeperGUI::appEvent()
+   REFRESH,    //!< MineSweeperGUI::refresh()
+   NUM_TIMERS
+};
+
+//! Totals for one timer
+struct Timing
+{
+   uint64_t count{0};
+   uint64_t total_ns{0};
+   uint64_t max_ns{0};
+};
+
+//! Totals across all threads
+struct Snapshot
+{
+   uint64_t counter[NUM_COUNTERS] = {};
+   Timing   timer[NUM_TIMERS];
+};
+
+#if MINESWEEPER_STATS
+
+static const unsigned NUM_SLOTS = 64;
+
+struct alignas(64) Slot
+{
+   std::atomic<uint64_t> counter[NUM_COUNTERS];
+   std::atomic<uint64_t> count[NUM_TIMERS];
+   std::atomic<uint64_t> total_ns[NUM_TIMERS];
+   std::atomic<uint64_t> max_ns[NUM_TIMERS];
+};
+
+//! Zero initialised storage for every slot
+inline Slot* getSlots()
+{
+   static Slot slots[NUM_SLOTS];
+   return slots;
+}
+
+//! Slot for the calling thread, threads beyond NUM_SLOTS share
+inline Slot& getSlot()
+{
+   static std::atomic<unsigned> next{0};
+   static thread_local Slot*    slot = &getSlots()[next.fetch_add(1, std::memory_order_relaxed) % NUM_SLOTS];
+   return *slot;
+}
+
+inline void raiseTo(std::atomic<uint64_t>& value, uint64_t n)
+{
+   uint64_t current = value.load(std::memory_order_relaxed);
+   while((n > current) && !value.compare_exchange_weak(current, n, std::memory_order_relaxed)) {}
+}
+
+#endif
+
+//! Add to a counter
+inline void add(CounterId counter, uint64_t n = 1)
+{
+#if MINESWEEPER_STATS
+   getSlot().counter[counter].fetch_add(n, std::memory_order_relaxed);
+#else
+   (void)counter;
+   (void)n;
+#endif
+}
+
+//! Raise a counter that records a maximum
+inline void raise(CounterId counter, uint64_t n)
+{
+#if MINESWEEPER_STATS
+   raiseTo(getSlot().counter[counter], n);
+#else
+   (void)counter;
+   (void)n;
+#endif
+}
+
+//! Record one timed call
+inline void addTime(TimerId timer, uint64_t ns)
+{
+#if MINESWEEPER_STATS
+   Slot& slot = getSlot();
+   slot.count[timer].fetch_add(1, std::memory_order_relaxed);
+   slot.total_ns[timer].fetch_add(ns, std::memory_order_relaxed);
+   raiseTo(slot.max_ns[timer], ns);
+#else
+   (void)timer;
+   (void)ns;
+#endif
+}
+
+//! Time the enclosing scope
+class ScopedTimer
+{
+public:
+#if MINESWEEPER_STATS
+   ScopedTimer(TimerId timer_)
+      : timer(timer_)
+      , start(std::chrono::steady_clock::now())
+   {
+   }
+
+   ~ScopedTimer()
+   {
+      addTime(timer, std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::steady_clock::now() - start).count());
+   }
+
+private:
+   TimerId                               timer;
+   std::chrono::steady_clock::time_point start;
+#else
+   ScopedTimer(TimerId) {}
+#endif
+};
+
+//! Sum every thread's counters
+inline Snapshot get()
+{
+   Snapshot snapshot;
+
+#if MINESWEEPER_STATS
+   for(unsigned i = 0; i < NUM_SLOTS; ++i)
+   {
+      const Slot& slot = getSlots()[i];
+
+      for(unsigned c = 0; c < NUM_COUNTERS; ++c)
+      {
+         uint64_t value = slot.counter[c].load(std::memory_order_relaxed);
+
+         if(c == FLOOD_MAX_DEPTH)
+            snapshot.counter[c] = value > snapshot.counter[c] ? value : snapshot.counter[c];
+         else
+            snapshot.counter[c] += value;
+      }
+
+      for(unsigned t = 0; t < NUM_TIMERS; ++t)
+      {
+         Timing&  timing = snapshot.timer[t];
+         uint64_t max_ns = slot.max_ns[t].load(std::memory_order_relaxed);
+
+         timing.count    += slot.count[t].load(std::memory_order_relaxed);
+         timing.total_ns += slot.total_ns[t].load(std::memory_order_relaxed);
+         timing.max_ns    = max_ns > timing.max_ns ? max_ns : timing.max_ns;
+      }
+   }
+#endif
+
+   return snapshot;
+}
+
+//! Zero every counter
+inline void clear()
+{
+#if MINESWEEPER_STATS
+   for(unsigned i = 0; i < NUM_SLOTS; ++i)
+   {
+      Slot& slot = getSlots()[i];
+
+      for(auto& value : slot.counter) value.store(0, std::memory_order_relaxed);
+      for(auto& value : slot.count) value.store(0, std::memory_order_relaxed);
+      for(auto& value : slot.total_ns) value.store(0, std::memory_order_relaxed);
+      for(auto& value : slot.max_ns) value.store(0, std::memory_order_relaxed);
+   }
+#endif
+}
+
+inline const char* getName(CounterId counter)
+{
+   static const char* name[NUM_COUNTERS] =
+      {"digs", "cells_revealed", "flood_max_depth", "replants", "resets"};
+   return name[counter];
+}
+
+inline const char* getName(TimerId timer)
+{
+   static const char* name[NUM_TIMERS] = {"app_event", "refresh"};
+   return name[timer];
+}
+
+//! Bounded text buffer that does not allocate
+class Writer
+{
+public:
+   Writer(char* buffer_, size_t size_)
+      : buffer(buffer_)
+      , size(size_)
+   {
+      buffer[0] = '\0';
+   }
+
+   size_t length() const { return used; }
+
+   void text(const char* s)
+   {
+      while((*s != '\0') && (used + 1 < size)) buffer[used++] = *s++;
+      buffer[used] = '\0';
+   }
+
+   void number(uint64_t value)
+   {
+      char digits[21];
+      char* p = digits + sizeof(digits);
+      *--p = '\0';
+      do { *--p = char('0' + value % 10); value /= 10; } while(value != 0);
+      text(p);
+   }
+
+private:
+   char*  buffer;
+   size_t size;
+   size_t used{0};
+};
+
+//! Format a snapshot as a JSON object, returns the length
+inline size_t formatJSON(const Snapshot& snapshot, char* buffer, size_t size)
+{
+   Writer out{buffer, size};
+
+   out.text("{\n");
+
+   for(unsigned c = 0; c < NUM_COUNTERS; ++c)
+   {
+      out.text("   \"");
+      out.text(getName(CounterId(c)));
+      out.text("\": ");
+      out.number(snapshot.counter[c]);
+      out.text(",\n");
+   }
+
+   for(unsigned t = 0; t < NUM_TIMERS; ++t)
+   {
+      const Timing& timing = snapshot.timer[t];
+
+      out.text("   \"");
+      out.text(getName(TimerId(t)));
+      out.text("\": {\"count\": ");
+      out.number(timing.count);
+      out.text(", \"total_ns\": ");
+      out.number(timing.total_ns);
+      out.text(", \"max_ns\": ");
+      out.number(timing.max_ns);
+      out.text(t + 1 < NUM_TIMERS ? "},\n" : "}\n");
+   }
+
+   out.text("}\n");
+
+   return out.length();
+}
+
+//! The counters as JSON
+inline std::string toJSON()
+{
+   char buffer[1024];
+   size_t length = formatJSON(get(), buffer, sizeof(buffer));
+   return std::string(buffer, length);
+}
+
+//! Write the counters as JSON to a file, replacing it, safe to call from a signal handler
+inline bool writeJSON(const char* path)
+{
+#if MINESWEEPER_STATS
+   char   buffer[1024];
+   size_t length = formatJSON(get(), buffer, sizeof(buffer));
+
+   int fd = ::open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+   if(fd < 0) return false;
+
+   bool ok = ::write(fd, buffer, length) == ssize_t(length);
+   ::close(fd);
+   return ok;
+#else
+   (void)path;
+   return false;
+#endif
+}
+
+inline char* getDumpPath()
+{
+   static char path[256] = {};
+   return path;
+}
+
+inline void dumpHandler(int) { writeJSON(getDumpPath()); }
+
+inline void dumpAtExit() { writeJSON(getDumpPath()); }
+
+//! Write the counters to the file named by $MINESWEEPER_STATS_JSON on exit and on SIGUSR1
+//
+//  Does nothing if the counters are not built in or the variable is not set
+inline void installDump()
+{
+   const char* path = std::getenv("MINESWEEPER_STATS_JSON");
+
+   if(!ENABLED || (path == nullptr) || (std::strlen(path) >= 256)) return;
+
+   std::strcpy(getDumpPath(), path);
+
+   std::atexit(dumpAtExit);
+#if defined(SIGUSR1)
+   std::signal(SIGUSR1, dumpHandler);
+#endif
+}
+
+} // namespace Stats
+
+} // namespace MineSweeper
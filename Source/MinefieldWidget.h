@@ -0,0 +1,389 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 John D. Haughton
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//------------------------------------------------------------------------------
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+
+#include "GUI/GUI.h"
+
+#include "MineSweeperGame.h"
+
+
+// 2 char "Mine" and "Flag" font
+static const uint8_t font_mines_data[] =
+{
+   0x08, 0x00, 0x88, 0x80, 0x5D, 0x00, 0x3E, 0x00, 0x67, 0x00, 0xEF, 0xC0, 0x7F, 0x00, 0x3E, 0x00,
+   0x5D, 0x00, 0x88, 0x80, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+   0x02, 0x00, 0x0E, 0x00, 0x3E, 0x00, 0x7E, 0x00, 0x3E, 0x00, 0x0E, 0x00, 0x02, 0x00, 0x02, 0x00,
+   0x02, 0x00, 0x07, 0x00, 0x3F, 0xC0, 0x3F, 0xC0, 0x00, 0x00, 0x00, 0x00
+};
+static const GUI::Font font_mines = {{10, 15}, 0x30, 0x31, 1, font_mines_data};
+
+
+//! A single widget covering the minefield, or a scrolling window onto it
+//
+//  Clicks are mapped to a plot arithmetically and plots are painted directly
+//  from the game state. When the board is larger than the viewport only the
+//  visible plots are visited, so the cost of a redraw depends on the size of
+//  the viewport and not the size of the board
+template <typename GAME>
+class MinefieldWidget : public GUI::Widget
+{
+public:
+   //! Event code fields for the plot co-ordinates
+   static const unsigned EV_COORD_BITS = 14;
+   static const unsigned EV_X_LSB      = 0;
+   static const unsigned EV_Y_LSB      = EV_COORD_BITS;
+   static const unsigned EV_MASK       = (1 << EV_COORD_BITS) - 1;
+
+   //! First event code bit not used by the plot co-ordinates
+   static const unsigned EV_FREE_LSB   = 2 * EV_COORD_BITS;
+
+   //! Pixel size of a plot at the initial zoom level
+   static const unsigned PLOT_SIZE     = 24;
+
+   MinefieldWidget(GUI::Widget*     parent,
+                   const GAME&      game_,
+                   unsigned         code_dig_,
+                   unsigned         code_flag_,
+                   const GUI::Font* font_digits_,
+                   unsigned         view_cols_,
+                   unsigned         view_rows_)
+      : GUI::Widget(parent)
+      , game(game_)
+      , code_dig(code_dig_)
+      , code_flag(code_flag_)
+      , font_digits(font_digits_)
+      , view_cols(view_cols_)
+      , view_rows(view_rows_)
+   {
+      assert(game.getWidth()  <= (EV_MASK + 1));
+      assert(game.getHeight() <= (EV_MASK + 1));
+   }
+
+   //! True if the board does not fit in the viewport
+   bool isScrollable() const
+   {
+      return (game.getWidth() > view_cols) || (game.getHeight() > view_rows);
+   }
+
+   //! Pixel size of the viewport, fixed at layout
+   unsigned getViewWidth()  const { return size.x; }
+   unsigned getViewHeight() const { return size.y; }
+
+   //! Current pixel size of a plot
+   unsigned getPlotSize() const { return ZOOM_PLOT_SIZE[zoom]; }
+
+   //! Map a pixel position to a plot, returns false if outside the field
+   bool getPlot(unsigned px, unsigned py, unsigned& x, unsigned& y) const
+   {
+      if((px < unsigned(pos.x)) || (py < unsigned(pos.y))) return false;
+
+      unsigned vx = px - pos.x;
+      unsigned vy = py - pos.y;
+
+      if((vx >= getViewWidth()) || (vy >= getViewHeight())) return false;
+
+      x = (vx + scroll_x) / getPlotSize();
+      y = (vy + scroll_y) / getPlotSize();
+
+      return (x < game.getWidth()) && (y < game.getHeight());
+   }
+
+   //! Call fn(x, y) for each plot that is at least partly visible
+   template <typename FN>
+   void forEachVisiblePlot(FN fn) const
+   {
+      unsigned size = getPlotSize();
+      unsigned x0   = scroll_x / size;
+      unsigned y0   = scroll_y / size;
+      unsigned x1   = std::min(game.getWidth(),  (scroll_x + getViewWidth()  + size - 1) / size);
+      unsigned y1   = std::min(game.getHeight(), (scroll_y + getViewHeight() + size - 1) / size);
+
+      for(unsigned y = y0; y < y1; ++y)
+      {
+         for(unsigned x = x0; x < x1; ++x)
+         {
+            fn(x, y);
+         }
+      }
+   }
+
+   //! Move the viewport by the given number of pixels
+   void scrollBy(signed dx, signed dy)
+   {
+      scroll_x = clampScroll(signed(scroll_x) + dx, game.getWidth(),  getViewWidth());
+      scroll_y = clampScroll(signed(scroll_y) + dy, game.getHeight(), getViewHeight());
+
+      setDirty();
+   }
+
+   //! Centre the viewport on the given plot
+   void scrollTo(unsigned x, unsigned y)
+   {
+      unsigned size = getPlotSize();
+
+      scroll_x = clampScroll(signed(x * size + size / 2) - signed(getViewWidth() / 2),
+                             game.getWidth(), getViewWidth());
+      scroll_y = clampScroll(signed(y * size + size / 2) - signed(getViewHeight() / 2),
+                             game.getHeight(), getViewHeight());
+
+      setDirty();
+   }
+
+   //! Plot at the centre of the viewport
+   void getCentrePlot(unsigned& x, unsigned& y) const
+   {
+      x = std::min((scroll_x + getViewWidth()  / 2) / getPlotSize(), game.getWidth()  - 1);
+      y = std::min((scroll_y + getViewHeight() / 2) / getPlotSize(), game.getHeight() - 1);
+   }
+
+   //! Zoom in (positive) or out (negative) keeping the centre of the view still
+   void zoomBy(signed steps)
+   {
+      signed new_zoom = std::max(0, std::min(signed(NUM_ZOOM) - 1, signed(zoom) + steps));
+
+      unsigned centre_x, centre_y;
+      getCentrePlot(centre_x, centre_y);
+
+      zoom = new_zoom;
+
+      scrollTo(centre_x, centre_y);
+   }
+
+   //! Event code for a plot
+   static unsigned getPlotCode(unsigned x, unsigned y)
+   {
+      return (y << EV_Y_LSB) | (x << EV_X_LSB);
+   }
+
+   //! Plot co-ordinates from an event code
+   static void decodePlot(unsigned code, unsigned& x, unsigned& y)
+   {
+      x = (code >> EV_X_LSB) & EV_MASK;
+      y = (code >> EV_Y_LSB) & EV_MASK;
+   }
+
+   //! Request a repaint after the game state has changed
+   void refresh()
+   {
+      setDirty();
+   }
+
+private:
+   //! Pixel size of a plot at each zoom level
+   static constexpr unsigned NUM_ZOOM = 5;
+   static constexpr unsigned ZOOM_PLOT_SIZE[NUM_ZOOM] = {6, 10, 16, 24, 32};
+   static constexpr unsigned INITIAL_ZOOM = 3;
+
+   //! Smallest plot size that has room for a glyph
+   static const unsigned GLYPH_PLOT_SIZE = 16;
+
+   //! Keep a scroll offset within the board
+   unsigned clampScroll(signed offset, unsigned plots, unsigned view) const
+   {
+      signed limit = signed(plots * getPlotSize()) - signed(view);
+
+      return unsigned(std::max(0, std::min(limit, offset)));
+   }
+
+   virtual void eventLayout() override
+   {
+      size.x = std::min(game.getWidth(),  view_cols) * PLOT_SIZE;
+      size.y = std::min(game.getHeight(), view_rows) * PLOT_SIZE;
+   }
+
+   virtual void eventDraw(GUI::Canvas& canvas) override
+   {
+      unsigned size = getPlotSize();
+
+      // Background where the board is smaller than the viewport when zoomed out
+      unsigned board_w = game.getWidth()  * size - scroll_x;
+      unsigned board_h = game.getHeight() * size - scroll_y;
+
+      if(board_w < getViewWidth())
+      {
+         canvas.fillRect(GUI::FACE, pos.x + board_w, pos.y,
+                         pos.x + getViewWidth() - 1, pos.y + getViewHeight() - 1);
+      }
+
+      if(board_h < getViewHeight())
+      {
+         canvas.fillRect(GUI::FACE, pos.x, pos.y + board_h,
+                         pos.x + getViewWidth() - 1, pos.y + getViewHeight() - 1);
+      }
+
+      forEachVisiblePlot([this, &canvas](unsigned x, unsigned y){ drawPlot(canvas, x, y); });
+   }
+
+   virtual void eventBtnPress(unsigned px, unsigned py, bool select, bool down) override
+   {
+      // Act on release, like a button
+      if(down) return;
+
+      unsigned x, y;
+      if(getPlot(px, py, x, y))
+      {
+         raiseEvent(this, (select ? code_dig : code_flag) | getPlotCode(x, y));
+      }
+   }
+
+   //! Fill a rectangle, clipped to the viewport
+   void fillClipped(GUI::Canvas& canvas, STB::Colour colour,
+                    signed x1, signed y1, signed x2, signed y2) const
+   {
+      x1 = std::max(x1, signed(pos.x));
+      y1 = std::max(y1, signed(pos.y));
+      x2 = std::min(x2, signed(pos.x + getViewWidth())  - 1);
+      y2 = std::min(y2, signed(pos.y + getViewHeight()) - 1);
+
+      if((x1 <= x2) && (y1 <= y2))
+      {
+         canvas.fillRect(colour, x1, y1, x2, y2);
+      }
+   }
+
+   //! Check if a rectangle is wholly inside the viewport
+   bool isInView(signed x1, signed y1, signed x2, signed y2) const
+   {
+      return (x1 >= signed(pos.x)) && (x2 < signed(pos.x + getViewWidth())) &&
+             (y1 >= signed(pos.y)) && (y2 < signed(pos.y + getViewHeight()));
+   }
+
+   //! Paint a single plot straight from the game state, clipped to the viewport
+   void drawPlot(GUI::Canvas& canvas, unsigned x, unsigned y)
+   {
+      unsigned size = getPlotSize();
+
+      signed x1 = signed(pos.x) + signed(x * size) - signed(scroll_x);
+      signed y1 = signed(pos.y) + signed(y * size) - signed(scroll_y);
+      signed x2 = x1 + size - 1;
+      signed y2 = y1 + size - 1;
+
+      STB::Colour      fg     = GUI::FOREGROUND;
+      STB::Colour      bg     = GUI::FACE;
+      const GUI::Font* font   = font_digits;
+      char             glyph  = '\0';
+      bool             raised = false;
+
+      bool mine;
+
+      switch(game.getPlotState(x, y, mine))
+      {
+      case MineSweeper::UNDUG:
+         raised = true;
+         break;
+
+      case MineSweeper::FLAG:
+         raised = true;
+         font   = &font_mines;
+         glyph  = '1';
+         break;
+
+      case MineSweeper::HOLE:
+         if(mine)
+         {
+            font  = &font_mines;
+            glyph = '0';
+         }
+         else
+         {
+            unsigned n = game.getNumberOfAdjacentMines(x, y);
+            assert(n <= 8);
+
+            static const STB::Colour colour[9] =
+               {0x000000, 0x0000C0, 0x008000, 0xC00000, 0x000040,
+                0x400000, 0x008080, 0x000000, 0x808080};
+
+            fg    = colour[n];
+            glyph = n == 0 ? '\0' : char('0' + n);
+         }
+         break;
+
+      case MineSweeper::EXPLOSION:
+         font  = &font_mines;
+         glyph = '0';
+         bg    = 0xE00000;
+         break;
+      }
+
+      const STB::Colour hilight = 0xFFFFFF;
+      const STB::Colour shadow  = 0x808080;
+
+      fillClipped(canvas, bg, x1, y1, x2, y2);
+
+      if(raised)
+      {
+         signed bevel = std::max(1u, size / 8);
+
+         fillClipped(canvas, hilight, x1, y1, x2, y1 + bevel - 1);
+         fillClipped(canvas, hilight, x1, y1, x1 + bevel - 1, y2);
+         fillClipped(canvas, shadow,  x1, y2 - bevel + 1, x2, y2);
+         fillClipped(canvas, shadow,  x2 - bevel + 1, y1, x2, y2);
+      }
+      else
+      {
+         // Thin grid line between dug plots
+         fillClipped(canvas, shadow, x1, y1, x2, y1);
+         fillClipped(canvas, shadow, x1, y1, x1, y2);
+      }
+
+      if(glyph == '\0') return;
+
+      signed gx = x1 + signed(size - GLYPH_WIDTH) / 2;
+      signed gy = y1 + signed(size - GLYPH_HEIGHT) / 2;
+
+      if((size >= GLYPH_PLOT_SIZE) && isInView(gx, gy, gx + GLYPH_WIDTH - 1, gy + GLYPH_HEIGHT - 1))
+      {
+         char text[2] = {glyph, '\0'};
+
+         canvas.drawText(fg, bg, gx, gy, font, text);
+      }
+      else
+      {
+         // Too small for a glyph, or the glyph would cross the edge of the
+         // viewport, show a block in the glyph colour
+         signed inset = size / 3;
+
+         fillClipped(canvas, fg, x1 + inset, y1 + inset, x2 - inset, y2 - inset);
+      }
+   }
+
+   //! Approximate glyph cell for centring, both fonts are 15 pixels high
+   static const unsigned GLYPH_WIDTH  = 10;
+   static const unsigned GLYPH_HEIGHT = 15;
+
+   const GAME&      game;
+   unsigned         code_dig;
+   unsigned         code_flag;
+   const GUI::Font* font_digits;
+   unsigned         view_cols;
+   unsigned         view_rows;
+   unsigned         zoom{INITIAL_ZOOM};
+   unsigned         scroll_x{0};
+   unsigned         scroll_y{0};
+};
+
+template <typename GAME>
+constexpr unsigned MinefieldWidget<GAME>::ZOOM_PLOT_SIZE[MinefieldWidget<GAME>::NUM_ZOOM];
@@ -20,9 +20,12 @@
 // SOFTWARE.
 //------------------------------------------------------------------------------
 
+#include <memory>
+
 #include "STB/ConsoleApp.h"
 
 #include "MineSweeperGUI.h"
+#include "MineSweeperStats.h"
 
 static const char* PROGRAM        = "MineSweeper";
 static const char* DESCRIPTION    = "An old game";
@@ -41,20 +44,23 @@ public:
 private:
    virtual int startConsoleApp() override
    {
+      MineSweeper::Stats::installDump();
+
       switch(level)
       {
       case 1: return MineSweeperGUI<9, 9>(10).eventLoop();
-#if !defined(PLT_SMALL_MEMORY)
-// Space on the stack will be allocated for the largest game
       case 2: return MineSweeperGUI<16, 16>(40).eventLoop();
       case 3: return MineSweeperGUI<30, 16>(99).eventLoop();
+#if !defined(PLT_SMALL_MEMORY)
+      // Too big for the stack, the view scrolls over the board
+      case 4: return std::make_unique<MineSweeperGUI<5000, 5000>>(5156250)->eventLoop();
 #endif
       }
 
       return 1;
    }
 
-   STB::Option<uint32_t> level{'l', "level", "Level of difficulty 1..3", 1};
+   STB::Option<uint32_t> level{'l', "level", "Level of difficulty 1..4", 1};
 };
 
 int main(int argc, const char* argv[])
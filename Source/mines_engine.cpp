@@ -0,0 +1,90 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 John D. Haughton
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//------------------------------------------------------------------------------
+
+
+// Engine-only build, game logic behind the flat C API with no GUI
+
+#include "mines_engine.h"
+
+#include "MineSweeperEngine.h"
+
+struct MinesGame
+{
+   MinesGame(unsigned level, uint32_t seed)
+      : engine(level, seed)
+   {
+   }
+
+   MineSweeper::Engine engine;
+};
+
+MinesGame* mines_create(unsigned level, uint32_t seed)
+{
+   if(!MineSweeper::Engine::isValidLevel(level)) return nullptr;
+
+   return new MinesGame(level, seed);
+}
+
+void mines_destroy(MinesGame* game)
+{
+   delete game;
+}
+
+unsigned mines_width(const MinesGame* game)
+{
+   return game->engine.getWidth();
+}
+
+unsigned mines_height(const MinesGame* game)
+{
+   return game->engine.getHeight();
+}
+
+void mines_reset(MinesGame* game, uint32_t seed)
+{
+   game->engine.reset(seed);
+}
+
+unsigned mines_dig(MinesGame* game, unsigned x, unsigned y)
+{
+   return game->engine.digHole(x, y);
+}
+
+unsigned mines_flag(MinesGame* game, unsigned x, unsigned y)
+{
+   return game->engine.plantUnplantFlag(x, y);
+}
+
+unsigned mines_progress(const MinesGame* game)
+{
+   return game->engine.getProgress();
+}
+
+unsigned mines_flags(const MinesGame* game)
+{
+   return game->engine.getNumberOfFlags();
+}
+
+unsigned mines_read_board(const MinesGame* game, uint8_t* buffer, unsigned size)
+{
+   return unsigned(game->engine.readBoard(buffer, size));
+}
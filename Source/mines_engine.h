@@ -0,0 +1,72 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 John D. Haughton
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//------------------------------------------------------------------------------
+
+
+// Flat C API of the engine-only WebAssembly module
+//
+// A game is created at one of the standard levels 1..3 and addressed by an
+// opaque handle. The whole visible board is read with one call into a caller
+// provided buffer, one byte per plot in row order, 0..8 for a hole with that
+// many adjacent mines, 9 undug, 10 flag, 11 mine, 12 explosion. Progress
+// values are 0 reset, 1 clearing, 2 detonated, 3 cleared
+
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct MinesGame MinesGame;
+
+//! Create a game at level 1..3, returns null for an unknown level
+MinesGame* mines_create(unsigned level, uint32_t seed);
+
+//! Destroy a game
+void mines_destroy(MinesGame* game);
+
+//! Board size
+unsigned mines_width(const MinesGame* game);
+unsigned mines_height(const MinesGame* game);
+
+//! Reset ready for a new game with the layout generated from the given seed
+void mines_reset(MinesGame* game, uint32_t seed);
+
+//! Dig a hole, returns the resulting progress
+unsigned mines_dig(MinesGame* game, unsigned x, unsigned y);
+
+//! Plant or unplant a flag, returns the resulting progress
+unsigned mines_flag(MinesGame* game, unsigned x, unsigned y);
+
+//! Current progress
+unsigned mines_progress(const MinesGame* game);
+
+//! Number of flags still available
+unsigned mines_flags(const MinesGame* game);
+
+//! Copy the visible board, returns bytes written or zero if size is too small
+unsigned mines_read_board(const MinesGame* game, uint8_t* buffer, unsigned size);
+
+#ifdef __cplusplus
+}
+#endif
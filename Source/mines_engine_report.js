@@ -0,0 +1,118 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 John D. Haughton
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//------------------------------------------------------------------------------
+
+// Report the size and instantiate time of WebAssembly modules
+//
+//    node mines_engine_report.js [--max-ratio=<r>] <module.wasm> <reference.wasm>...
+//
+// Each module is compiled and instantiated with stub imports, so modules with
+// different JS glue are compared on the same terms. The best of several runs
+// is reported, along with the ratio of the first module to the second. With
+// --max-ratio the exit status is non-zero if the first module is more than
+// that fraction of the size of the second
+
+'use strict';
+
+const fs = require('fs');
+
+const RUNS = 20;
+
+function stubImports(module)
+{
+   const imports = {};
+
+   for(const entry of WebAssembly.Module.imports(module))
+   {
+      let value;
+
+      switch(entry.kind)
+      {
+      case 'function': value = () => 0;                                            break;
+      case 'memory':   value = new WebAssembly.Memory({initial: 256, maximum: 32768}); break;
+      case 'table':    value = new WebAssembly.Table({initial: 4096, element: 'anyfunc'}); break;
+      case 'global':   value = new WebAssembly.Global({value: 'i32', mutable: true}, 0);   break;
+      }
+
+      imports[entry.module] = imports[entry.module] || {};
+      imports[entry.module][entry.name] = value;
+   }
+
+   return imports;
+}
+
+async function report(file)
+{
+   const bytes = fs.readFileSync(file);
+   let   best  = Infinity;
+
+   for(let run = 0; run < RUNS; ++run)
+   {
+      const start  = process.hrtime.bigint();
+      const module = await WebAssembly.compile(bytes);
+      await WebAssembly.instantiate(module, stubImports(module));
+      const ms     = Number(process.hrtime.bigint() - start) / 1e6;
+
+      best = Math.min(best, ms);
+   }
+
+   console.log(`${file}: ${bytes.length} bytes, instantiate ${best.toFixed(2)} ms`);
+
+   return {bytes: bytes.length, ms: best};
+}
+
+(async () =>
+{
+   let   max_ratio = null;
+   const files     = [];
+
+   for(const arg of process.argv.slice(2))
+   {
+      if(arg.startsWith('--max-ratio='))
+         max_ratio = Number(arg.slice('--max-ratio='.length));
+      else
+         files.push(arg);
+   }
+
+   const results = [];
+
+   for(const file of files)
+   {
+      results.push(await report(file));
+   }
+
+   if(results.length < 2) return;
+
+   const size_ratio = results[0].bytes / results[1].bytes;
+   const time_ratio = results[0].ms / results[1].ms;
+
+   console.log(`ratio: size ${size_ratio.toFixed(3)}, instantiate ${time_ratio.toFixed(3)}`);
+
+   if((max_ratio !== null) && !(size_ratio <= max_ratio))
+   {
+      console.error(`${files[0]} is more than ${max_ratio} of the size of ${files[1]}`);
+      process.exit(1);
+   }
+})().catch((error) =>
+{
+   console.error(error.message);
+   process.exit(1);
+});
@@ -0,0 +1,75 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 John D. Haughton
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//------------------------------------------------------------------------------
+
+
+#include <cstdio>
+
+#include "STB/ConsoleApp.h"
+
+#include "MineSweeperFuzz.h"
+
+static const char* PROGRAM        = "mines_fuzz";
+static const char* DESCRIPTION    = "Differential fuzzer for the MineSweeper engines";
+static const char* LINK           = "https://github.com/AnotherJohnH/MineSweeper";
+static const char* AUTHOR         = "John D. Haughton";
+static const char* COPYRIGHT_YEAR = "2026";
+
+class MineSweeperFuzzApp : public STB::ConsoleApp
+{
+public:
+   MineSweeperFuzzApp()
+      : ConsoleApp(PROGRAM, DESCRIPTION, LINK, AUTHOR, COPYRIGHT_YEAR)
+   {
+   }
+
+private:
+   virtual int startConsoleApp() override
+   {
+      MineSweeper::Fuzz::Runner runner{threads};
+
+      printf("threads   : %u\n", runner.getNumberOfThreads());
+
+      MineSweeper::Fuzz::Result result = runner.run(seconds, seed);
+
+      printf("cases     : %llu\n", (unsigned long long)result.cases);
+      printf("moves     : %llu\n", (unsigned long long)result.moves);
+      printf("elapsed   : %.3f s\n", result.seconds);
+      printf("rate      : %.0f moves/s\n", result.getMovesPerSecond());
+
+      if(result.failed)
+      {
+         printf("\nFAIL %s", result.report.c_str());
+         return 1;
+      }
+
+      return 0;
+   }
+
+   STB::Option<uint32_t> seconds{'d', "duration", "Seconds to run for", 10};
+   STB::Option<uint32_t> threads{'t', "threads",  "Worker threads (0 for all cores)", 0};
+   STB::Option<uint32_t> seed{   's', "seed",     "Seed for the first worker", 1};
+};
+
+int main(int argc, const char* argv[])
+{
+   return MineSweeperFuzzApp().parseArgsAndStart(argc, argv);
+}
@@ -0,0 +1,378 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 John D. Haughton
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//------------------------------------------------------------------------------
+
+
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <deque>
+#include <thread>
+#include <vector>
+
+#include "STB/ConsoleApp.h"
+
+#include "MineSweeperRandom.h"
+#include "MineSweeperServer.h"
+#include "MineSweeperSimulator.h"
+
+static const char* PROGRAM        = "mines_load";
+static const char* DESCRIPTION    = "Load generator for mines_server";
+static const char* LINK           = "https://github.com/AnotherJohnH/MineSweeper";
+static const char* AUTHOR         = "John D. Haughton";
+static const char* COPYRIGHT_YEAR = "2026";
+
+namespace Protocol = MineSweeper::Protocol;
+
+using Clock = std::chrono::steady_clock;
+
+//! Totals from one client thread
+struct LoadResult
+{
+   uint64_t               requests{0};
+   uint64_t               errors{0};
+   uint64_t               games{0};
+   MineSweeper::Histogram latency;  //!< Request to response (ns)
+
+   void merge(const LoadResult& other)
+   {
+      requests += other.requests;
+      errors   += other.errors;
+      games    += other.games;
+      latency.merge(other.latency);
+   }
+};
+
+//! Plays many sessions over a few connections, keeping one request outstanding per session
+class LoadClient
+{
+public:
+   LoadClient(unsigned level_, uint64_t seed)
+      : level(level_)
+      , random(seed)
+   {
+   }
+
+   //! Connect and open the given number of sessions
+   bool connect(const char* path, unsigned number_of_sessions)
+   {
+      sockaddr_un addr{};
+      addr.sun_family = AF_UNIX;
+      if(std::strlen(path) >= sizeof(addr.sun_path)) return false;
+      std::strcpy(addr.sun_path, path);
+
+      connections.emplace_back();
+      Connection& connection = connections.back();
+
+      connection.fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+      if(::connect(connection.fd, (const sockaddr*)&addr, sizeof(addr)) != 0) return false;
+
+      ::fcntl(connection.fd, F_SETFL, ::fcntl(connection.fd, F_GETFL) | O_NONBLOCK);
+
+      connection.sessions.resize(number_of_sessions);
+
+      for(uint32_t i = 0; i < number_of_sessions; ++i)
+      {
+         send(connection, i, Protocol::NEW);
+      }
+
+      return true;
+   }
+
+   //! Run until the deadline then wait for outstanding responses
+   void run(Clock::time_point deadline)
+   {
+      std::vector<pollfd> fds;
+
+      Clock::time_point give_up = deadline + std::chrono::seconds(5);
+
+      for(;;)
+      {
+         Clock::time_point now = Clock::now();
+
+         sending = now < deadline;
+
+         bool outstanding = false;
+         for(Connection& connection : connections) outstanding |= !connection.pending.empty();
+
+         if(!outstanding || (now > give_up)) break;
+
+         fds.clear();
+
+         for(Connection& connection : connections)
+         {
+            transmit(connection);
+
+            short events = POLLIN;
+            if(connection.sent < connection.out.size()) events |= POLLOUT;
+            fds.push_back({connection.fd, events, 0});
+         }
+
+         if(::poll(fds.data(), fds.size(), 10) <= 0) continue;
+
+         for(size_t i = 0; i < fds.size(); ++i)
+         {
+            if(fds[i].revents & (POLLIN | POLLHUP | POLLERR)) receive(connections[i]);
+         }
+      }
+
+      for(Connection& connection : connections) ::close(connection.fd);
+   }
+
+   const LoadResult& getResult() const { return result; }
+
+private:
+   struct Session
+   {
+      uint32_t id{0};
+      uint32_t seed{0};
+   };
+
+   struct Pending
+   {
+      uint32_t          session;
+      uint8_t           op;
+      Clock::time_point sent;
+   };
+
+   struct Connection
+   {
+      int                  fd{-1};
+      std::vector<Session> sessions;
+      std::deque<Pending>  pending;
+      std::vector<uint8_t> in;
+      std::vector<uint8_t> out;
+      size_t               sent{0};
+   };
+
+   void send(Connection& connection, uint32_t index, uint8_t op)
+   {
+      const Protocol::Level& size    = Protocol::getLevel(level);
+      Session&               session = connection.sessions[index];
+
+      Protocol::Request request;
+      request.op      = op;
+      request.level   = uint8_t(level);
+      request.session = session.id;
+      request.seed    = session.seed;
+      request.x       = uint8_t(random.below(size.width));
+      request.y       = uint8_t(random.below(size.height));
+
+      if(connection.sent == connection.out.size())
+      {
+         connection.out.clear();
+         connection.sent = 0;
+      }
+
+      size_t at = connection.out.size();
+      connection.out.resize(at + Protocol::REQUEST_SIZE);
+      request.encode(&connection.out[at]);
+
+      connection.pending.push_back({index, op, Clock::now()});
+   }
+
+   //! Choose the next request for a session from the response to its last one
+   uint8_t next(Session& session, uint8_t op, const Protocol::Response& response)
+   {
+      if(response.status != Protocol::OK)
+      {
+         ++result.errors;
+         return Protocol::NEW;
+      }
+
+      switch(op)
+      {
+      case Protocol::NEW:
+         session.id = response.session;
+         return Protocol::DIG;
+
+      case Protocol::DIG:
+      case Protocol::FLAG:
+         if((response.progress == MineSweeper::CLEARED) || (response.progress == MineSweeper::DETONATED))
+         {
+            ++result.games;
+            return Protocol::CLOSE;
+         }
+         switch(random.below(8))
+         {
+         case 0:  return Protocol::STATE;
+         case 1:  return Protocol::FLAG;
+         default: return Protocol::DIG;
+         }
+
+      case Protocol::CLOSE:
+         ++session.seed;
+         return Protocol::NEW;
+
+      default:
+         return Protocol::DIG;
+      }
+   }
+
+   void receive(Connection& connection)
+   {
+      uint8_t buffer[64 * 1024];
+
+      ssize_t n = ::read(connection.fd, buffer, sizeof(buffer));
+      if(n <= 0) return;
+
+      connection.in.insert(connection.in.end(), buffer, buffer + n);
+
+      Clock::time_point now  = Clock::now();
+      size_t            used = 0;
+
+      while(!connection.pending.empty() && ((connection.in.size() - used) >= Protocol::RESPONSE_SIZE))
+      {
+         const Pending& pending = connection.pending.front();
+
+         Protocol::Response response;
+         response.decode(&connection.in[used]);
+
+         size_t size = Protocol::RESPONSE_SIZE;
+         if((pending.op == Protocol::STATE) && (response.status == Protocol::OK))
+         {
+            size += Protocol::getBoardBytes(level);
+         }
+
+         if((connection.in.size() - used) < size) break;
+
+         used += size;
+
+         ++result.requests;
+         result.latency.add(std::chrono::duration_cast<std::chrono::nanoseconds>(now - pending.sent).count());
+
+         uint32_t index = pending.session;
+         uint8_t  op    = next(connection.sessions[index], pending.op, response);
+
+         connection.pending.pop_front();
+
+         if(sending) send(connection, index, op);
+      }
+
+      connection.in.erase(connection.in.begin(), connection.in.begin() + used);
+   }
+
+   void transmit(Connection& connection)
+   {
+      while(connection.sent < connection.out.size())
+      {
+         ssize_t n = ::send(connection.fd, &connection.out[connection.sent],
+                            connection.out.size() - connection.sent, MSG_NOSIGNAL);
+         if(n <= 0) return;
+         connection.sent += n;
+      }
+   }
+
+   unsigned                level;
+   MineSweeper::Random     random;
+   bool                    sending{true};
+   std::vector<Connection> connections;
+   LoadResult              result;
+};
+
+class MineSweeperLoadApp : public STB::ConsoleApp
+{
+public:
+   MineSweeperLoadApp()
+      : ConsoleApp(PROGRAM, DESCRIPTION, LINK, AUTHOR, COPYRIGHT_YEAR)
+   {
+   }
+
+private:
+   virtual int startConsoleApp() override
+   {
+      std::signal(SIGPIPE, SIG_IGN);
+
+      if(!Protocol::isValidLevel(level))
+      {
+         fprintf(stderr, "ERROR: unknown level %u\n", unsigned(level));
+         return 1;
+      }
+
+      unsigned number_of_threads     = std::max(1u, unsigned(threads));
+      unsigned number_of_connections = std::max(number_of_threads, unsigned(connections));
+
+      std::vector<std::unique_ptr<LoadClient>> clients;
+
+      for(unsigned i = 0; i < number_of_threads; ++i)
+      {
+         clients.emplace_back(new LoadClient(level, i + 1));
+      }
+
+      for(unsigned i = 0; i < number_of_connections; ++i)
+      {
+         unsigned first = uint64_t(sessions) * i / number_of_connections;
+         unsigned last  = uint64_t(sessions) * (i + 1) / number_of_connections;
+
+         if(!clients[i % number_of_threads]->connect(socket_path, last - first))
+         {
+            fprintf(stderr, "ERROR: failed to connect to \"%s\"\n", (const char*)socket_path);
+            return 1;
+         }
+      }
+
+      Clock::time_point start    = Clock::now();
+      Clock::time_point deadline = start + std::chrono::seconds(seconds);
+
+      std::vector<std::thread> thread;
+      for(auto& client : clients)
+      {
+         thread.emplace_back([&client, deadline]{ client->run(deadline); });
+      }
+
+      LoadResult total;
+      for(unsigned i = 0; i < number_of_threads; ++i)
+      {
+         thread[i].join();
+         total.merge(clients[i]->getResult());
+      }
+
+      double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+
+      printf("sessions  : %u\n", unsigned(sessions));
+      printf("connects  : %u\n", number_of_connections);
+      printf("threads   : %u\n", number_of_threads);
+      printf("requests  : %llu\n", (unsigned long long)total.requests);
+      printf("errors    : %llu\n", (unsigned long long)total.errors);
+      printf("games     : %llu\n", (unsigned long long)total.games);
+      printf("elapsed   : %.3f s\n", elapsed);
+      printf("rate      : %.0f requests/s\n", total.requests / elapsed);
+      printf("latency   : p50 %.1f us, p90 %.1f us, p99 %.1f us, p99.9 %.1f us\n",
+             total.latency.getPercentile(50) / 1000.0,
+             total.latency.getPercentile(90) / 1000.0,
+             total.latency.getPercentile(99) / 1000.0,
+             total.latency.getPercentile(99.9) / 1000.0);
+
+      return 0;
+   }
+
+   STB::Option<const char*> socket_path{'S', "socket",      "Unix domain socket of the server", "/tmp/mines.sock"};
+   STB::Option<uint32_t>    level{      'l', "level",       "Level of difficulty 1..3", 3};
+   STB::Option<uint32_t>    sessions{   's', "sessions",    "Concurrent sessions", 10000};
+   STB::Option<uint32_t>    connections{'c', "connections", "Connections shared by the sessions", 64};
+   STB::Option<uint32_t>    threads{    't', "threads",     "Client threads", 1};
+   STB::Option<uint32_t>    seconds{    'd', "duration",    "Seconds to run for", 10};
+};
+
+int main(int argc, const char* argv[])
+{
+   return MineSweeperLoadApp().parseArgsAndStart(argc, argv);
+}
@@ -0,0 +1,96 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 John D. Haughton
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//------------------------------------------------------------------------------
+
+
+#include <csignal>
+#include <cstdio>
+
+#include "STB/ConsoleApp.h"
+
+#include "MineSweeperServer.h"
+#include "MineSweeperStats.h"
+
+static const char* PROGRAM        = "mines_server";
+static const char* DESCRIPTION    = "Headless multi-session MineSweeper server";
+static const char* LINK           = "https://github.com/AnotherJohnH/MineSweeper";
+static const char* AUTHOR         = "John D. Haughton";
+static const char* COPYRIGHT_YEAR = "2026";
+
+static MineSweeper::Server* running_server = nullptr;
+
+static void stopServer(int)
+{
+   if(running_server != nullptr) running_server->stop();
+}
+
+class MineSweeperServerApp : public STB::ConsoleApp
+{
+public:
+   MineSweeperServerApp()
+      : ConsoleApp(PROGRAM, DESCRIPTION, LINK, AUTHOR, COPYRIGHT_YEAR)
+   {
+   }
+
+private:
+   virtual int startConsoleApp() override
+   {
+      MineSweeper::Stats::installDump();
+
+      std::signal(SIGPIPE, SIG_IGN);
+
+      MineSweeper::Server server{threads, sessions};
+
+      if(stdio)
+      {
+         return server.serveStream(0, 1) ? 0 : 1;
+      }
+
+      if(!server.listen(socket_path))
+      {
+         fprintf(stderr, "ERROR: failed to listen on \"%s\"\n", (const char*)socket_path);
+         return 1;
+      }
+
+      printf("socket    : %s\n", (const char*)socket_path);
+      printf("shards    : %u\n", server.getNumberOfShards());
+      fflush(stdout);
+
+      running_server = &server;
+      std::signal(SIGINT, stopServer);
+      std::signal(SIGTERM, stopServer);
+
+      server.run();
+
+      running_server = nullptr;
+      return 0;
+   }
+
+   STB::Option<const char*> socket_path{'S', "socket",   "Unix domain socket to listen on", "/tmp/mines.sock"};
+   STB::Option<bool>        stdio{      'i', "stdio",    "Serve a single client on stdin and stdout", false};
+   STB::Option<uint32_t>    threads{    't', "threads",  "Shards, each with its own thread (0 for all cores)", 0};
+   STB::Option<uint32_t>    sessions{   'm', "sessions", "Maximum sessions per shard", uint32_t(MineSweeper::Shard::MAX_SESSIONS)};
+};
+
+int main(int argc, const char* argv[])
+{
+   return MineSweeperServerApp().parseArgsAndStart(argc, argv);
+}
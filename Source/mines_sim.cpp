@@ -0,0 +1,156 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 John D. Haughton
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//------------------------------------------------------------------------------
+
+
+#include <cstdio>
+
+#include "STB/ConsoleApp.h"
+
+#include "MineSweeperDynamicGame.h"
+#include "MineSweeperGame.h"
+#include "MineSweeperPlayer.h"
+#include "MineSweeperSimulator.h"
+#include "MineSweeperSolver.h"
+#include "MineSweeperStats.h"
+
+static const char* PROGRAM        = "mines_sim";
+static const char* DESCRIPTION    = "Headless batch simulator for MineSweeper";
+static const char* LINK           = "https://github.com/AnotherJohnH/MineSweeper";
+static const char* AUTHOR         = "John D. Haughton";
+static const char* COPYRIGHT_YEAR = "2026";
+
+class MineSweeperSimApp : public STB::ConsoleApp
+{
+public:
+   MineSweeperSimApp()
+      : ConsoleApp(PROGRAM, DESCRIPTION, LINK, AUTHOR, COPYRIGHT_YEAR)
+   {
+   }
+
+private:
+   virtual int startConsoleApp() override
+   {
+      MineSweeper::Stats::installDump();
+
+      if(width != 0)
+      {
+         return simulate<MineSweeper::DynamicGame>([this]{
+            return std::unique_ptr<MineSweeper::DynamicGame>(
+               new MineSweeper::DynamicGame(width, height, mines));
+         });
+      }
+
+      switch(level)
+      {
+      case 1: return simulate<MineSweeper::Game<9, 9>>(newGame<9, 9>(10));
+      case 2: return simulate<MineSweeper::Game<16, 16>>(newGame<16, 16>(40));
+      case 3: return simulate<MineSweeper::Game<30, 16>>(newGame<30, 16>(99));
+      }
+
+      return 1;
+   }
+
+   template <unsigned WIDTH, unsigned HEIGHT>
+   static std::function<std::unique_ptr<MineSweeper::Game<WIDTH, HEIGHT>>()> newGame(unsigned mines)
+   {
+      return [mines]{
+         return std::unique_ptr<MineSweeper::Game<WIDTH, HEIGHT>>(
+            new MineSweeper::Game<WIDTH, HEIGHT>(mines));
+      };
+   }
+
+   //! The solver needs the board size at compile time
+   template <typename GAME>
+   static MineSweeper::Player<GAME>* newSolverPlayer(GAME*) { return nullptr; }
+
+   template <unsigned WIDTH, unsigned HEIGHT>
+   static MineSweeper::Player<MineSweeper::Game<WIDTH, HEIGHT>>* newSolverPlayer(
+      MineSweeper::Game<WIDTH, HEIGHT>*)
+   {
+      return new MineSweeper::SolverPlayer<MineSweeper::Game<WIDTH, HEIGHT>>;
+   }
+
+   template <typename GAME>
+   static std::unique_ptr<MineSweeper::Player<GAME>> newPlayer(unsigned player)
+   {
+      switch(player)
+      {
+      case 1: return std::unique_ptr<MineSweeper::Player<GAME>>(new MineSweeper::RandomPlayer<GAME>);
+      case 2: return std::unique_ptr<MineSweeper::Player<GAME>>(newSolverPlayer((GAME*)nullptr));
+      }
+
+      return nullptr;
+   }
+
+   template <typename GAME>
+   int simulate(typename MineSweeper::Simulator<GAME>::GameFactory new_game)
+   {
+      unsigned player_type = player;
+
+      if(newPlayer<GAME>(player_type) == nullptr)
+      {
+         fprintf(stderr, "ERROR: unknown player %u\n", player_type);
+         return 1;
+      }
+
+      MineSweeper::Simulator<GAME> simulator{new_game,
+                                             [=]{ return newPlayer<GAME>(player_type); },
+                                             threads};
+
+      std::unique_ptr<GAME>                    game       = new_game();
+      std::unique_ptr<MineSweeper::Player<GAME>> one_player = newPlayer<GAME>(player_type);
+
+      printf("board     : %ux%u\n", game->getWidth(), game->getHeight());
+      printf("player    : %s\n", one_player->getName());
+      printf("threads   : %u\n", simulator.getNumberOfThreads());
+
+      MineSweeper::SimulationResult result = simulator.run(games, seed);
+
+      printf("games     : %llu\n", (unsigned long long)result.games);
+      printf("win rate  : %.4f%%\n", result.getWinRate() * 100.0);
+      printf("stalled   : %llu\n", (unsigned long long)result.stalls);
+      printf("revealed  : %.2f plots/game\n", result.getAverageRevealed());
+      printf("elapsed   : %.3f s\n", result.seconds);
+      printf("rate      : %.0f games/s\n", result.getGamesPerSecond());
+      printf("game time : p50 %llu ns, p90 %llu ns, p99 %llu ns, p99.9 %llu ns\n",
+             (unsigned long long)result.game_time.getPercentile(50),
+             (unsigned long long)result.game_time.getPercentile(90),
+             (unsigned long long)result.game_time.getPercentile(99),
+             (unsigned long long)result.game_time.getPercentile(99.9));
+
+      return 0;
+   }
+
+   STB::Option<uint32_t> level{  'l', "level",   "Level of difficulty 1..3", 1};
+   STB::Option<uint32_t> width{  'W', "width",   "Custom board width (overrides level)", 0};
+   STB::Option<uint32_t> height{ 'H', "height",  "Custom board height", 16};
+   STB::Option<uint32_t> mines{  'm', "mines",   "Custom number of mines", 99};
+   STB::Option<uint32_t> games{  'g', "games",   "Number of games to play", 1000000};
+   STB::Option<uint32_t> threads{'t', "threads", "Worker threads (0 for all cores)", 0};
+   STB::Option<uint32_t> seed{   's', "seed",    "Seed for the first game", 1};
+   STB::Option<uint32_t> player{ 'p', "player",  "Automatic player 1=random 2=solver", 1};
+};
+
+int main(int argc, const char* argv[])
+{
+   return MineSweeperSimApp().parseArgsAndStart(argc, argv);
+}
@@ -0,0 +1,246 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 John D. Haughton
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//------------------------------------------------------------------------------
+
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+//! Minimal micro-benchmark support for the bench_MS target
+namespace Bench {
+
+using Clock = std::chrono::steady_clock;
+
+//! A registered benchmark
+struct Case
+{
+   const char* group;
+   const char* name;
+   void (*fn)();
+};
+
+inline std::vector<Case>& getCases()
+{
+   static std::vector<Case> cases;
+   return cases;
+}
+
+//! A reported measurement
+struct Result
+{
+   std::string name;
+   double      ns_per_op;
+   double      allocs_per_op;
+};
+
+inline std::vector<Result>& getResults()
+{
+   static std::vector<Result> results;
+   return results;
+}
+
+//! Name of the benchmark currently running
+inline std::string& getCurrentCase()
+{
+   static std::string name;
+   return name;
+}
+
+//! Number of heap allocations so far, counted by operator new in benchMain.cpp
+inline std::atomic<uint64_t>& getAllocations()
+{
+   static std::atomic<uint64_t> allocations{0};
+   return allocations;
+}
+
+//! Allocations per call measured by the last nsPerOp()
+inline double& getLastAllocsPerOp()
+{
+   static double allocs_per_op = 0.0;
+   return allocs_per_op;
+}
+
+struct Register
+{
+   Register(const char* group, const char* name, void (*fn)())
+   {
+      getCases().push_back({group, name, fn});
+   }
+};
+
+//! Stop the optimiser discarding a computed value
+template <typename TYPE>
+inline void keep(const TYPE& value)
+{
+   asm volatile("" : : "r"(&value) : "memory");
+}
+
+//! Time fn, repeating until at least min_seconds have elapsed, return ns per call
+template <typename FN>
+double nsPerOp(FN fn, double min_seconds = 0.2)
+{
+   for(unsigned iterations = 1; ; iterations *= 2)
+   {
+      uint64_t          allocations = getAllocations();
+      Clock::time_point start       = Clock::now();
+
+      for(unsigned i = 0; i < iterations; ++i)
+      {
+         fn();
+      }
+
+      double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+
+      if(elapsed >= min_seconds)
+      {
+         getLastAllocsPerOp() = double(getAllocations() - allocations) / iterations;
+         return elapsed * 1e9 / iterations;
+      }
+   }
+}
+
+//! Report a single measurement, a negative allocation count uses that seen by the last nsPerOp()
+inline void report(const char* label, double ns_per_op, double allocs_per_op = -1.0)
+{
+   if(allocs_per_op < 0.0)
+   {
+      allocs_per_op = getLastAllocsPerOp();
+   }
+
+   printf("   %-48s %14.1f ns/op %10.2f allocs/op\n", label, ns_per_op, allocs_per_op);
+
+   getResults().push_back({getCurrentCase() + "/" + label, ns_per_op, allocs_per_op});
+
+   getLastAllocsPerOp() = 0.0;
+}
+
+//! Run every benchmark whose "group.name" contains the filter string
+inline int runAll(const char* filter)
+{
+   for(const auto& c : getCases())
+   {
+      std::string name = std::string(c.group) + "." + c.name;
+
+      if((filter != nullptr) && (strstr(name.c_str(), filter) == nullptr))
+      {
+         continue;
+      }
+
+      getCurrentCase() = name;
+
+      printf("%s\n", getCurrentCase().c_str());
+      c.fn();
+   }
+
+   return 0;
+}
+
+//! Write the results as JSON, one benchmark per line
+inline bool writeJSON(const char* filename)
+{
+   FILE* fp = fopen(filename, "w");
+   if(fp == nullptr) return false;
+
+   fprintf(fp, "{\n   \"benchmarks\": [\n");
+
+   const auto& results = getResults();
+
+   for(size_t i = 0; i < results.size(); ++i)
+   {
+      fprintf(fp, "      {\"name\": \"%s\", \"ns_per_op\": %.1f, \"allocs_per_op\": %.2f}%s\n",
+              results[i].name.c_str(), results[i].ns_per_op, results[i].allocs_per_op,
+              i + 1 < results.size() ? "," : "");
+   }
+
+   fprintf(fp, "   ]\n}\n");
+   fclose(fp);
+   return true;
+}
+
+//! Read results written by writeJSON()
+inline bool readJSON(const char* filename, std::vector<Result>& results)
+{
+   FILE* fp = fopen(filename, "r");
+   if(fp == nullptr) return false;
+
+   char line[512];
+   char name[256];
+
+   while(fgets(line, sizeof(line), fp) != nullptr)
+   {
+      Result result;
+
+      if(sscanf(line, " {\"name\": \"%255[^\"]\", \"ns_per_op\": %lf, \"allocs_per_op\": %lf",
+                name, &result.ns_per_op, &result.allocs_per_op) == 3)
+      {
+         result.name = name;
+         results.push_back(result);
+      }
+   }
+
+   fclose(fp);
+   return true;
+}
+
+//! Print the change in each benchmark present in both runs
+inline int compare(const char* base_file, const char* test_file)
+{
+   std::vector<Result> base;
+   std::vector<Result> test;
+
+   if(!readJSON(base_file, base) || !readJSON(test_file, test))
+   {
+      fprintf(stderr, "ERROR: failed to read benchmark results\n");
+      return 1;
+   }
+
+   printf("%-64s %12s %12s %8s %10s\n", "benchmark", "base ns/op", "ns/op", "change", "allocs/op");
+
+   for(const auto& t : test)
+   {
+      for(const auto& b : base)
+      {
+         if(b.name != t.name) continue;
+
+         double change = b.ns_per_op > 0.0 ? 100.0 * (t.ns_per_op - b.ns_per_op) / b.ns_per_op : 0.0;
+
+         printf("%-64s %12.1f %12.1f %+7.1f%% %+10.2f\n",
+                t.name.c_str(), b.ns_per_op, t.ns_per_op, change, t.allocs_per_op - b.allocs_per_op);
+         break;
+      }
+   }
+
+   return 0;
+}
+
+} // namespace Bench
+
+#define BENCH(GROUP, NAME) \
+   static void bench_##GROUP##_##NAME(); \
+   static Bench::Register register_##GROUP##_##NAME(#GROUP, #NAME, bench_##GROUP##_##NAME); \
+   static void bench_##GROUP##_##NAME()
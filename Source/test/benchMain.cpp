@@ -0,0 +1,82 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 John D. Haughton
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//------------------------------------------------------------------------------
+
+
+#include <cstdlib>
+#include <new>
+
+#include "Bench.h"
+
+// Count every heap allocation so benchmarks can report allocations per op
+
+void* operator new(size_t size)
+{
+   ++Bench::getAllocations();
+
+   void* ptr = malloc(size == 0 ? 1 : size);
+   if(ptr == nullptr) throw std::bad_alloc();
+   return ptr;
+}
+
+void* operator new[](size_t size)
+{
+   return operator new(size);
+}
+
+void operator delete(void* ptr) noexcept { free(ptr); }
+void operator delete[](void* ptr) noexcept { free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { free(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { free(ptr); }
+
+//! Usage: bench_MS [--json <file>] [<filter>]
+//!        bench_MS --compare <base.json> <test.json>
+int main(int argc, const char* argv[])
+{
+   const char* filter    = nullptr;
+   const char* json_file = nullptr;
+
+   for(int i = 1; i < argc; ++i)
+   {
+      if((strcmp(argv[i], "--compare") == 0) && (i + 2 < argc))
+      {
+         return Bench::compare(argv[i + 1], argv[i + 2]);
+      }
+      else if((strcmp(argv[i], "--json") == 0) && (i + 1 < argc))
+      {
+         json_file = argv[++i];
+      }
+      else
+      {
+         filter = argv[i];
+      }
+   }
+
+   int status = Bench::runAll(filter);
+
+   if((json_file != nullptr) && !Bench::writeJSON(json_file))
+   {
+      fprintf(stderr, "ERROR: failed to write \"%s\"\n", json_file);
+      return 1;
+   }
+
+   return status;
+}
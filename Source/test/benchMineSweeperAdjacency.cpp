@@ -0,0 +1,84 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 John D. Haughton
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//------------------------------------------------------------------------------
+
+
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../MineSweeperAdjacency.h"
+#include "../MineSweeperRandom.h"
+
+#include "Bench.h"
+
+//! Whole board adjacent mine counts, per plot, for each kernel
+template <unsigned WIDTH, unsigned HEIGHT>
+static void benchKernels(unsigned mines_per_64)
+{
+   using Board = MineSweeper::BitBoard<WIDTH, HEIGHT>;
+
+   std::string size  = std::to_string(WIDTH) + "x" + std::to_string(HEIGHT);
+   double      plots = double(WIDTH) * HEIGHT;
+
+   std::unique_ptr<Board> mines{new Board()};
+   MineSweeper::Random    random{1};
+
+   for(unsigned y = 0; y < HEIGHT; ++y)
+   {
+      for(unsigned x = 0; x < WIDTH; ++x)
+      {
+         if(random.below(64) < mines_per_64) mines->set(x, y);
+      }
+   }
+
+   std::vector<uint8_t> counts(WIDTH * HEIGHT);
+
+   Bench::report((size + " scalar (per plot)").c_str(), Bench::nsPerOp([&]{
+      MineSweeper::countAdjacentScalar(*mines, counts.data());
+      Bench::keep(counts[0]);
+   }) / plots);
+
+   Bench::report((size + " bit-sliced (per plot)").c_str(), Bench::nsPerOp([&]{
+      MineSweeper::countAdjacentBitSliced(*mines, counts.data());
+      Bench::keep(counts[0]);
+   }) / plots);
+
+#if defined(MINESWEEPER_X86)
+   if(__builtin_cpu_supports("avx2"))
+   {
+      Bench::report((size + " AVX2 (per plot)").c_str(), Bench::nsPerOp([&]{
+         MineSweeper::countAdjacentAVX2(*mines, counts.data());
+         Bench::keep(counts[0]);
+      }) / plots);
+   }
+#endif
+
+   Bench::report((size + " board value").c_str(), Bench::nsPerOp([&]{
+      Bench::keep(MineSweeper::getBoardValue(*mines));
+   }));
+}
+
+BENCH(MineSweeperAdjacency, kernels_30x16)     { benchKernels<30, 16>(13); }
+BENCH(MineSweeperAdjacency, kernels_256x256)   { benchKernels<256, 256>(13); }
+BENCH(MineSweeperAdjacency, kernels_1024x1024) { benchKernels<1024, 1024>(13); }
+BENCH(MineSweeperAdjacency, kernels_4096x4096) { benchKernels<4096, 4096>(13); }
@@ -0,0 +1,92 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 John D. Haughton
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//------------------------------------------------------------------------------
+
+
+#include <memory>
+#include <vector>
+
+#include "../MineSweeperBatch.h"
+
+#include "Bench.h"
+
+static const unsigned GAMES = 10000;
+static const unsigned STEPS = 64;
+
+//! The same random plot sequence for both layouts
+static std::vector<uint16_t> makePlots()
+{
+   MineSweeper::Random   random{5};
+   std::vector<uint16_t> plots(GAMES * STEPS);
+
+   for(auto& plot : plots) plot = uint16_t(random.below(81));
+
+   return plots;
+}
+
+BENCH(MineSweeperBatch, games_9x9)
+{
+   std::vector<uint16_t> plots = makePlots();
+
+   std::vector<MineSweeper::Game<9, 9>> games;
+   games.reserve(GAMES);
+   for(unsigned i = 0; i < GAMES; ++i) games.emplace_back(/* num_of_mines */ 10);
+
+   Bench::report("10000 x 9x9 vector<Game> reset (per game)", Bench::nsPerOp([&]{
+      for(unsigned i = 0; i < GAMES; ++i) games[i].reset(i + 1);
+   }) / GAMES);
+
+   Bench::report("10000 x 9x9 vector<Game> play (per game)", Bench::nsPerOp([&]{
+      for(unsigned i = 0; i < GAMES; ++i) games[i].reset(i + 1);
+
+      for(unsigned i = 0; i < GAMES; ++i) games[i].digHole(4, 4);
+
+      for(unsigned step = 0; step < STEPS; ++step)
+      {
+         const uint16_t* step_plots = &plots[step * GAMES];
+
+         for(unsigned i = 0; i < GAMES; ++i)
+         {
+            games[i].digHole(step_plots[i] % 9, step_plots[i] / 9);
+         }
+      }
+   }) / GAMES);
+
+   auto batch = std::make_unique<MineSweeper::GameBatch<9, 9>>(GAMES, /* num_of_mines */ 10);
+
+   Bench::report("10000 x 9x9 GameBatch reset (per game)", Bench::nsPerOp([&]{
+      batch->reset(1);
+   }) / GAMES);
+
+   Bench::report("10000 x 9x9 GameBatch play (per game)", Bench::nsPerOp([&]{
+      batch->reset(1);
+      batch->digHole(4, 4);
+
+      for(unsigned step = 0; step < STEPS; ++step)
+      {
+         batch->digHoles(&plots[step * GAMES]);
+      }
+   }) / GAMES);
+
+   Bench::report("10000 x 9x9 GameBatch countProgress", Bench::nsPerOp([&]{
+      Bench::keep(batch->countProgress());
+   }));
+}
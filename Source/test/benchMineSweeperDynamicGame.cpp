@@ -0,0 +1,53 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 John D. Haughton
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//------------------------------------------------------------------------------
+
+
+#include <string>
+
+#include "../MineSweeperDynamicGame.h"
+
+#include "Bench.h"
+
+static void benchDynamic(unsigned width, unsigned height, unsigned mines)
+{
+   std::string size = std::to_string(width) + "x" + std::to_string(height);
+
+   MineSweeper::DynamicGame game{width, height, mines};
+
+   Bench::report((size + " dynamic adjacent lookup (per board)").c_str(), Bench::nsPerOp([&]{
+      unsigned total = 0;
+      for(unsigned y = 0; y < height; ++y)
+         for(unsigned x = 0; x < width; ++x)
+            total += game.getNumberOfAdjacentMines(x, y);
+      Bench::keep(total);
+   }));
+
+   Bench::report((size + " dynamic reset + first dig").c_str(), Bench::nsPerOp([&]{
+      game.reset();
+      game.digHole(width / 2, height / 2);
+   }));
+}
+
+BENCH(MineSweeperDynamicGame, dynamic_9x9)       { benchDynamic(9, 9, 10); }
+BENCH(MineSweeperDynamicGame, dynamic_30x16)     { benchDynamic(30, 16, 99); }
+BENCH(MineSweeperDynamicGame, dynamic_200x200)   { benchDynamic(200, 200, 8000); }
+BENCH(MineSweeperDynamicGame, dynamic_2000x2000) { benchDynamic(2000, 2000, 40000); }
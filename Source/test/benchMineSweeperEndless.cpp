@@ -0,0 +1,78 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 John D. Haughton
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//------------------------------------------------------------------------------
+
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+#include "../MineSweeperEndless.h"
+
+#include "Bench.h"
+
+//! Rows swept by the bot, two chunks high
+static const int32_t BAND = 2 * MineSweeper::EndlessGame::CHUNK_SIZE;
+
+//! A bot that knows the layout sweeps a band to the right digging every safe plot
+BENCH(MineSweeperEndless, explore)
+{
+   using Clock = std::chrono::steady_clock;
+
+   MineSweeper::EndlessGame game{/* density */ 20, /* seed */ 1, /* memory cap */ 4 * 1024 * 1024};
+
+   game.digHole(0, BAND / 2);
+
+   uint64_t checkpoint = 1000000;
+   int32_t  x          = 0;
+   auto     start      = Clock::now();
+
+   while(checkpoint <= 8000000)
+   {
+      for(int32_t y = 0; y < BAND; ++y)
+      {
+         bool mine;
+         if((game.getPlotState(x, y, mine) == MineSweeper::UNDUG) && !mine)
+         {
+            game.digHole(x, y);
+         }
+      }
+
+      ++x;
+
+      if(game.getNumberOfHoles() < checkpoint) continue;
+
+      double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+
+      std::string label = std::to_string(checkpoint / 1000000) + "M plots dug";
+
+      Bench::report((label + " (per plot)").c_str(), ns / game.getNumberOfHoles(), 0.0);
+
+      printf("   %-48s %14.1f KB (%zu resident, %zu compact, %zu resolved)\n",
+             (label + " memory").c_str(), game.getMemoryBytes() / 1024.0,
+             game.getNumberOfResidentChunks(), game.getNumberOfCompactChunks(),
+             game.getNumberOfResolvedChunks());
+
+      checkpoint *= 2;
+   }
+
+   Bench::keep(x);
+}
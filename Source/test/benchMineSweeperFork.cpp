@@ -0,0 +1,82 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 John D. Haughton
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//------------------------------------------------------------------------------
+
+
+
+#include <memory>
+#include <string>
+
+#include "../MineSweeperFork.h"
+#include "../MineSweeperGame.h"
+
+#include "Bench.h"
+
+//! Cost of keeping a copy of a game in progress, trying a move and restoring it
+template <unsigned WIDTH, unsigned HEIGHT>
+static void benchFork(unsigned mines)
+{
+   using Game = MineSweeper::Game<WIDTH, HEIGHT>;
+   using Fork = MineSweeper::GameFork<WIDTH, HEIGHT>;
+
+   std::string size = std::to_string(WIDTH) + "x" + std::to_string(HEIGHT);
+
+   auto game = std::make_unique<Game>(mines);
+   game->setSafeZone(MineSweeper::SAFE_NEIGHBOURHOOD);
+   game->digHole(WIDTH / 2, HEIGHT / 2);
+
+   auto copy = std::make_unique<Game>(mines);
+
+   Bench::report((size + " Game copy").c_str(), Bench::nsPerOp([&]{
+      *copy = *game;
+      Bench::keep(*copy);
+   }));
+
+   auto snapshot = std::make_unique<typename Game::Snapshot>();
+
+   Bench::report((size + " Game save").c_str(), Bench::nsPerOp([&]{
+      game->save(*snapshot);
+      Bench::keep(*snapshot);
+   }));
+
+   Bench::report((size + " Game restore").c_str(), Bench::nsPerOp([&]{
+      copy->restore(*snapshot);
+      Bench::keep(*copy);
+   }));
+
+   auto fork = std::make_unique<Fork>(*game);
+   auto trial = std::make_unique<Fork>(*fork);
+
+   Bench::report((size + " GameFork copy").c_str(), Bench::nsPerOp([&]{
+      *trial = *fork;
+      Bench::keep(*trial);
+   }));
+
+   Bench::report((size + " GameFork copy + flag").c_str(), Bench::nsPerOp([&]{
+      *trial = *fork;
+      trial->plantUnplantFlag(0, 0);
+      Bench::keep(*trial);
+   }));
+}
+
+BENCH(MineSweeperFork, fork_9x9)     { benchFork<9, 9>(10); }
+BENCH(MineSweeperFork, fork_30x16)   { benchFork<30, 16>(99); }
+BENCH(MineSweeperFork, fork_200x200) { benchFork<200, 200>(8000); }
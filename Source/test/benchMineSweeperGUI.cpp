@@ -0,0 +1,62 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 John D. Haughton
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//------------------------------------------------------------------------------
+
+
+
+#include <memory>
+#include <string>
+
+#include "../MineSweeperGUI.h"
+
+#include "Bench.h"
+
+template <unsigned WIDTH, unsigned HEIGHT>
+static void benchRefresh(unsigned mines)
+{
+   using Hook = MineSweeperGUITestHook;
+
+   auto        gui  = std::make_unique<MineSweeperGUI<WIDTH, HEIGHT>>(mines);
+   auto&       game = Hook::getGame(*gui);
+   std::string size = std::to_string(WIDTH) + "x" + std::to_string(HEIGHT);
+
+   Bench::report((size + " refresh (no change)").c_str(), Bench::nsPerOp([&]{
+      Hook::refresh(*gui);
+   }));
+
+   Bench::report((size + " reset + refresh (all plots)").c_str(), Bench::nsPerOp([&]{
+      game.reset();
+      Hook::refresh(*gui);
+   }));
+
+   Bench::report((size + " reset + first dig + refresh").c_str(), Bench::nsPerOp([&]{
+      game.reset();
+      game.digHole(WIDTH / 2, HEIGHT / 2);
+      Hook::refresh(*gui);
+   }));
+}
+
+BENCH(MineSweeperGUI, refresh_9x9)       { benchRefresh<9, 9>(10); }
+BENCH(MineSweeperGUI, refresh_16x16)     { benchRefresh<16, 16>(40); }
+BENCH(MineSweeperGUI, refresh_30x16)     { benchRefresh<30, 16>(99); }
+BENCH(MineSweeperGUI, refresh_64x64)     { benchRefresh<64, 64>(600); }
+BENCH(MineSweeperGUI, refresh_256x256)   { benchRefresh<256, 256>(10000); }
+BENCH(MineSweeperGUI, refresh_5000x5000) { benchRefresh<5000, 5000>(5156250); }
@@ -0,0 +1,295 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 John D. Haughton
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//------------------------------------------------------------------------------
+
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../MineSweeperGame.h"
+
+#include "Bench.h"
+
+//! Adjacent mine count by a clamped 3x3 scan, as Game did before the count table
+template <typename GAME>
+static unsigned scanAdjacentMines(const GAME& game, signed x, signed y, signed width, signed height)
+{
+   unsigned count = 0;
+
+   for(signed scan_y = std::max(y - 1, 0); scan_y <= std::min(y + 1, height - 1); ++scan_y)
+   {
+      for(signed scan_x = std::max(x - 1, 0); scan_x <= std::min(x + 1, width - 1); ++scan_x)
+      {
+         bool mine;
+         game.getPlotState(scan_x, scan_y, mine);
+         if(mine) ++count;
+      }
+   }
+
+   return count;
+}
+
+template <unsigned WIDTH, unsigned HEIGHT>
+static void benchAdjacent(unsigned mines)
+{
+   std::string size = std::to_string(WIDTH) + "x" + std::to_string(HEIGHT);
+
+   auto game = std::make_unique<MineSweeper::Game<WIDTH, HEIGHT>>(mines);
+
+   Bench::report((size + " adjacent scan (per board)").c_str(), Bench::nsPerOp([&]{
+      unsigned total = 0;
+      for(unsigned y = 0; y < HEIGHT; ++y)
+         for(unsigned x = 0; x < WIDTH; ++x)
+            total += scanAdjacentMines(*game, x, y, WIDTH, HEIGHT);
+      Bench::keep(total);
+   }));
+
+   Bench::report((size + " adjacent lookup (per board)").c_str(), Bench::nsPerOp([&]{
+      unsigned total = 0;
+      for(unsigned y = 0; y < HEIGHT; ++y)
+         for(unsigned x = 0; x < WIDTH; ++x)
+            total += game->getNumberOfAdjacentMines(x, y);
+      Bench::keep(total);
+   }));
+
+   // The game queries made by MineSweeperGUI::refresh() on an opened board
+   game->digHole(WIDTH / 2, HEIGHT / 2);
+
+   Bench::report((size + " refresh queries (per board)").c_str(), Bench::nsPerOp([&]{
+      unsigned total = 0;
+      for(unsigned y = 0; y < HEIGHT; ++y)
+      {
+         for(unsigned x = 0; x < WIDTH; ++x)
+         {
+            bool mine;
+            if((game->getPlotState(x, y, mine) == MineSweeper::HOLE) && !mine)
+               total += game->getNumberOfAdjacentMines(x, y);
+         }
+      }
+      Bench::keep(total);
+   }));
+
+   Bench::report((size + " reset").c_str(), Bench::nsPerOp([&]{
+      game->reset();
+   }));
+
+   Bench::report((size + " reset + first dig").c_str(), Bench::nsPerOp([&]{
+      game->reset();
+      game->digHole(WIDTH / 2, HEIGHT / 2);
+   }));
+
+   // Each flag toggle on an undug plot ends in checkIfCleared()
+   game->reset();
+   game->digHole(WIDTH / 2, HEIGHT / 2);
+
+   unsigned flag_x = 0;
+   unsigned flag_y = 0;
+   for(bool mine; game->getPlotState(flag_x, flag_y, mine) != MineSweeper::UNDUG;)
+   {
+      if(++flag_x == WIDTH) { flag_x = 0; ++flag_y; }
+   }
+
+   Bench::report((size + " flag + unflag (checkIfCleared)").c_str(), Bench::nsPerOp([&]{
+      game->plantUnplantFlag(flag_x, flag_y);
+      game->plantUnplantFlag(flag_x, flag_y);
+   }));
+}
+
+BENCH(MineSweeperGame, adjacent_9x9)       { benchAdjacent<9, 9>(10); }
+BENCH(MineSweeperGame, adjacent_16x16)     { benchAdjacent<16, 16>(40); }
+BENCH(MineSweeperGame, adjacent_30x16)     { benchAdjacent<30, 16>(99); }
+BENCH(MineSweeperGame, adjacent_200x200)   { benchAdjacent<200, 200>(8000); }
+BENCH(MineSweeperGame, adjacent_1000x1000) { benchAdjacent<1000, 1000>(200000); }
+
+//! Time the first dig on a large sparse board, which opens one big region
+template <unsigned WIDTH, unsigned HEIGHT>
+static void benchFloodFill(unsigned mines)
+{
+   std::string size = std::to_string(WIDTH) + "x" + std::to_string(HEIGHT);
+
+   auto game = std::make_unique<MineSweeper::Game<WIDTH, HEIGHT>>(mines);
+
+   const unsigned REPEATS = 8;
+
+   double   elapsed     = 0.0;
+   unsigned revealed    = 0;
+   uint64_t allocations = 0;
+
+   for(unsigned i = 0; i < REPEATS; ++i)
+   {
+      game->reset();
+
+      uint64_t                 before = Bench::getAllocations();
+      Bench::Clock::time_point start  = Bench::Clock::now();
+      game->digHole(WIDTH / 2, HEIGHT / 2);
+      elapsed += std::chrono::duration<double>(Bench::Clock::now() - start).count();
+      allocations += Bench::getAllocations() - before;
+
+      for(unsigned y = 0; y < HEIGHT; ++y)
+      {
+         for(unsigned x = 0; x < WIDTH; ++x)
+         {
+            bool mine;
+            if(game->getPlotState(x, y, mine) == MineSweeper::HOLE) ++revealed;
+         }
+      }
+   }
+
+   Bench::report((size + " flood fill (per dig)").c_str(), elapsed * 1e9 / REPEATS,
+                 double(allocations) / REPEATS);
+   Bench::report((size + " flood fill (per plot)").c_str(), elapsed * 1e9 / revealed,
+                 double(allocations) / revealed);
+}
+
+BENCH(MineSweeperGame, flood_fill_250x250)   { benchFloodFill<250, 250>(625); }
+BENCH(MineSweeperGame, flood_fill_500x500)   { benchFloodFill<500, 500>(2500); }
+BENCH(MineSweeperGame, flood_fill_1000x1000) { benchFloodFill<1000, 1000>(10000); }
+
+BENCH(MineSweeperGame, high_density_first_dig)
+{
+   MineSweeper::Game<30, 16> game{/* 75% */ 360};
+
+   Bench::report("30x16/360 reset + first dig", Bench::nsPerOp([&]{
+      game.reset();
+      game.digHole(15, 8);
+   }));
+
+   game.setSafeZone(MineSweeper::SAFE_NEIGHBOURHOOD);
+
+   Bench::report("30x16/360 reset + first dig (safe 3x3)", Bench::nsPerOp([&]{
+      game.reset();
+      game.digHole(15, 8);
+   }));
+}
+
+//! Cost of recording a large first dig in the history and of undoing and redoing it
+template <unsigned WIDTH, unsigned HEIGHT>
+static void benchUndo(unsigned mines)
+{
+   std::string size = std::to_string(WIDTH) + "x" + std::to_string(HEIGHT);
+
+   auto game = std::make_unique<MineSweeper::Game<WIDTH, HEIGHT>>(mines);
+
+   Bench::report((size + " reset + first dig").c_str(), Bench::nsPerOp([&]{
+      game->reset();
+      game->digHole(WIDTH / 2, HEIGHT / 2);
+   }));
+
+   game->enableHistory(1 << 20);
+
+   Bench::report((size + " reset + first dig (history)").c_str(), Bench::nsPerOp([&]{
+      game->reset();
+      game->digHole(WIDTH / 2, HEIGHT / 2);
+   }));
+
+   printf("   %-48s %14zu bytes\n", (size + " history after first dig").c_str(), game->getHistoryBytes());
+
+   Bench::report((size + " undo + redo first dig").c_str(), Bench::nsPerOp([&]{
+      game->undo();
+      game->redo();
+   }));
+}
+
+BENCH(MineSweeperGame, undo_30x16)   { benchUndo<30, 16>(99); }
+BENCH(MineSweeperGame, undo_250x250) { benchUndo<250, 250>(625); }
+
+//! Finish a game by digging every safe plot and flagging every mine, one call at a time and as a batch
+template <unsigned WIDTH, unsigned HEIGHT>
+static void benchApplyMoves(unsigned mines)
+{
+   std::string size = std::to_string(WIDTH) + "x" + std::to_string(HEIGHT);
+
+   auto game = std::make_unique<MineSweeper::Game<WIDTH, HEIGHT>>(mines);
+
+   auto start = [&]{
+      game->reset(/* seed */ 1);
+      game->digHole(WIDTH / 2, HEIGHT / 2);
+   };
+
+   // The deductions a solver would make, in the order Solver::apply() makes them
+   std::vector<MineSweeper::Move> moves;
+
+   start();
+
+   for(bool flag_mines : {false, true})
+   {
+      for(uint16_t y = 0; y < HEIGHT; ++y)
+      {
+         for(uint16_t x = 0; x < WIDTH; ++x)
+         {
+            bool mine;
+            if((game->getPlotState(x, y, mine) == MineSweeper::UNDUG) && (mine == flag_mines))
+            {
+               moves.push_back({x, y, flag_mines ? MineSweeper::Move::FLAG : MineSweeper::Move::DIG});
+            }
+         }
+      }
+   }
+
+   double reset = Bench::nsPerOp(start);
+
+   double single = Bench::nsPerOp([&]{
+      start();
+      for(const MineSweeper::Move& move : moves)
+      {
+         if(move.type == MineSweeper::Move::DIG)
+            game->digHole(move.x, move.y);
+         else
+            game->plantUnplantFlag(move.x, move.y);
+      }
+      Bench::keep(game->getProgress());
+   });
+
+   double batch = Bench::nsPerOp([&]{
+      start();
+      Bench::keep(game->applyMoves(moves.data(), moves.size()).progress);
+   });
+
+   Bench::report((size + " single moves (per move)").c_str(), (single - reset) / moves.size());
+   Bench::report((size + " batched moves (per move)").c_str(), (batch - reset) / moves.size());
+}
+
+BENCH(MineSweeperGame, apply_moves_30x16)   { benchApplyMoves<30, 16>(99); }
+BENCH(MineSweeperGame, apply_moves_200x200) { benchApplyMoves<200, 200>(8000); }
+
+//! Plant a layout and make the first dig, the neighbour scans of planting and flood fill
+template <unsigned WIDTH, unsigned HEIGHT>
+static void benchNeighbours(unsigned mines)
+{
+   std::string size = std::to_string(WIDTH) + "x" + std::to_string(HEIGHT);
+
+   MineSweeper::Game<WIDTH, HEIGHT> game{mines};
+
+   // Cycle through a fixed set of layouts so runs are comparable
+   uint64_t seed = 0;
+
+   Bench::report((size + " reset(seed) + first dig").c_str(), Bench::nsPerOp([&]{
+      game.reset((seed++ % 256) + 1);
+      game.digHole(WIDTH / 2, HEIGHT / 2);
+      Bench::keep(game.getProgress());
+   }));
+}
+
+BENCH(MineSweeperGame, neighbours_9x9)   { benchNeighbours<9, 9>(10); }
+BENCH(MineSweeperGame, neighbours_16x16) { benchNeighbours<16, 16>(40); }
+BENCH(MineSweeperGame, neighbours_30x16) { benchNeighbours<30, 16>(99); }
@@ -0,0 +1,97 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 John D. Haughton
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//------------------------------------------------------------------------------
+
+
+
+#include <cstdio>
+
+#include "../MineSweeperGame.h"
+#include "../MineSweeperLog.h"
+
+#include "Bench.h"
+
+using Expert = MineSweeper::Game<30,16>;
+
+BENCH(MineSweeperLog, replay)
+{
+   const char*    LOG_FILE = "benchMineSweeperLog.mslog";
+   const unsigned GAMES    = 2000;
+
+   remove(LOG_FILE);
+
+   // Record games of random flags, ticks and digs
+   {
+      MineSweeper::LogWriter        writer(LOG_FILE);
+      Expert                        game(99);
+      MineSweeper::Recorder<Expert> recorder(game, writer);
+      MineSweeper::Random           random(1);
+
+      recorder.setSafeZone(MineSweeper::SAFE_NEIGHBOURHOOD);
+
+      for(unsigned g = 0; g < GAMES; ++g)
+      {
+         recorder.reset(g);
+
+         for(unsigned move = 0; move < 2000; ++move)
+         {
+            unsigned x = random.below(30);
+            unsigned y = random.below(16);
+
+            switch(random.below(8))
+            {
+            case 0:  recorder.plantUnplantFlag(x, y); break;
+            case 1:  recorder.tick(); break;
+            default:
+               {
+                  bool mine;
+                  // avoid mines so that games are long
+                  if(game.getPlotState(x, y, mine) == MineSweeper::UNDUG && !mine) recorder.digHole(x, y);
+               }
+               break;
+            }
+         }
+      }
+   }
+
+   MineSweeper::LogFile file(LOG_FILE);
+   Expert               game(99);
+
+   // Without checkpoints every replay decodes the game from the start
+   MineSweeper::Replayer<Expert> full(file.begin(), file.end(), ~uint64_t(0));
+
+   uint64_t moves = 0;
+   for(size_t g = 0; g < full.getNumberOfGames(); ++g) moves += full.getNumberOfMoves(g);
+
+   double ns = Bench::nsPerOp([&]{
+      for(size_t g = 0; g < full.getNumberOfGames(); ++g) full.replay(game, g);
+   });
+
+   Bench::report("30x16/99 replay from start (per move)", ns / moves, Bench::getLastAllocsPerOp() / moves);
+
+   MineSweeper::Replayer<Expert> replayer(file.begin(), file.end(), 256);
+
+   Bench::report("30x16/99 jump to last move (per game)", Bench::nsPerOp([&]{
+      replayer.replay(game, GAMES / 2);
+   }));
+
+   remove(LOG_FILE);
+}
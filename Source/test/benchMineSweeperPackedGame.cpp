@@ -0,0 +1,78 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 John D. Haughton
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//------------------------------------------------------------------------------
+
+#include <memory>
+#include <string>
+
+#include "../MineSweeperGame.h"
+#include "../MineSweeperPackedGame.h"
+
+#include "Bench.h"
+
+//! Time the first dig of a run of seeds, the opening is larger and more winding as the density rises
+template <template <unsigned, unsigned> class GAME, unsigned WIDTH, unsigned HEIGHT>
+static void benchFirstDig(const char* engine, unsigned mines)
+{
+   std::string label = std::string(engine) + " " + std::to_string(WIDTH) + "x" +
+                       std::to_string(HEIGHT) + " " + std::to_string(mines) + " mines";
+
+   auto game = std::make_unique<GAME<WIDTH, HEIGHT>>(mines);
+
+   const unsigned SEEDS = 8;
+
+   double   elapsed  = 0.0;
+   unsigned revealed = 0;
+
+   for(unsigned seed = 1; seed <= SEEDS; ++seed)
+   {
+      game->reset(seed);
+
+      Bench::Clock::time_point start = Bench::Clock::now();
+      game->digHole(WIDTH / 2, HEIGHT / 2);
+      elapsed += std::chrono::duration<double>(Bench::Clock::now() - start).count();
+
+      for(unsigned y = 0; y < HEIGHT; ++y)
+      {
+         for(unsigned x = 0; x < WIDTH; ++x)
+         {
+            bool mine;
+            if(game->getPlotState(x, y, mine) == MineSweeper::HOLE) ++revealed;
+         }
+      }
+   }
+
+   Bench::report((label + " (per dig)").c_str(), elapsed * 1e9 / SEEDS, 0.0);
+   Bench::report((label + " (per plot)").c_str(), elapsed * 1e9 / revealed, 0.0);
+}
+
+template <unsigned WIDTH, unsigned HEIGHT>
+static void benchBoth(unsigned mines)
+{
+   benchFirstDig<MineSweeper::Game, WIDTH, HEIGHT>("game  ", mines);
+   benchFirstDig<MineSweeper::PackedGame, WIDTH, HEIGHT>("packed", mines);
+}
+
+BENCH(MineSweeperPackedGame, first_dig_250x250)   { benchBoth<250, 250>(625); }
+BENCH(MineSweeperPackedGame, first_dig_1000x1000) { benchBoth<1000, 1000>(10000); }
+
+//! Near the density where openings stop spanning the board they are long and winding
+BENCH(MineSweeperPackedGame, winding_1000x1000)   { benchBoth<1000, 1000>(80000); }
@@ -0,0 +1,56 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 John D. Haughton
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//------------------------------------------------------------------------------
+
+
+#include <memory>
+#include <vector>
+
+#include "../MineSweeperProbability.h"
+#include "../MineSweeperSolver.h"
+
+#include "Bench.h"
+
+BENCH(MineSweeperProbability, expert)
+{
+   MineSweeper::Probability<30, 16> probability;
+   MineSweeper::Solver<30, 16>      solver;
+
+   // Expert boards where the solver has got as far as it can
+   std::vector<std::unique_ptr<MineSweeper::Game<30, 16>>> games;
+
+   for(uint64_t seed = 1; games.size() < 64; ++seed)
+   {
+      std::unique_ptr<MineSweeper::Game<30, 16>> game{new MineSweeper::Game<30, 16>(99, seed)};
+
+      game->setSafeZone(MineSweeper::SAFE_NEIGHBOURHOOD);
+      game->digHole(15, 8);
+      solver.play(*game);
+
+      if(game->getProgress() == MineSweeper::CLEARING) games.push_back(std::move(game));
+   }
+
+   unsigned next = 0;
+
+   Bench::report("30x16/99 probabilities when stuck", Bench::nsPerOp([&]{
+      Bench::keep(probability.solve(*games[next++ % games.size()]));
+   }));
+}
@@ -0,0 +1,47 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 John D. Haughton
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//------------------------------------------------------------------------------
+
+
+#include "../MineSweeperSolver.h"
+
+#include "Bench.h"
+
+BENCH(MineSweeperSolver, expert)
+{
+   MineSweeper::Solver<30, 16> solver;
+   MineSweeper::Game<30, 16>   game{99};
+
+   game.setSafeZone(MineSweeper::SAFE_NEIGHBOURHOOD);
+   game.digHole(15, 8);
+
+   Bench::report("30x16/99 solve after first dig", Bench::nsPerOp([&]{
+      Bench::keep(solver.solve(game));
+   }));
+
+   uint64_t seed = 1;
+
+   Bench::report("30x16/99 reset + first dig + play", Bench::nsPerOp([&]{
+      game.reset(seed++);
+      game.digHole(15, 8);
+      Bench::keep(solver.play(game));
+   }));
+}
@@ -0,0 +1,122 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 John D. Haughton
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//------------------------------------------------------------------------------
+
+
+
+#include <memory>
+#include <vector>
+
+#include "../MineSweeperAdjacency.h"
+#include "../MineSweeperRandom.h"
+
+#include "STB/Test.h"
+
+//! Check every kernel against the scalar reference on random boards of several densities
+template <unsigned WIDTH, unsigned HEIGHT>
+static void checkKernels()
+{
+   using Board = MineSweeper::BitBoard<WIDTH, HEIGHT>;
+
+   MineSweeper::Random random{WIDTH * 1000 + HEIGHT};
+
+   std::unique_ptr<Board> mines{new Board()};
+
+   std::vector<uint8_t> expected(WIDTH * HEIGHT);
+   std::vector<uint8_t> actual(WIDTH * HEIGHT);
+
+   for(unsigned density = 0; density <= 8; ++density)
+   {
+      mines->clearAll();
+
+      for(unsigned y = 0; y < HEIGHT; ++y)
+      {
+         for(unsigned x = 0; x < WIDTH; ++x)
+         {
+            if(random.below(8) < density) mines->set(x, y);
+         }
+      }
+
+      MineSweeper::countAdjacentScalar(*mines, expected.data());
+
+      if(density == 8)
+      {
+         // Every plot is mined, the window of a corner plot holds 4
+         EXPECT_EQ(expected[0], 4);
+      }
+
+      MineSweeper::countAdjacentBitSliced(*mines, actual.data());
+      EXPECT_TRUE(actual == expected);
+
+#if defined(MINESWEEPER_X86)
+      if(__builtin_cpu_supports("avx2"))
+      {
+         MineSweeper::countAdjacentAVX2(*mines, actual.data());
+         EXPECT_TRUE(actual == expected);
+      }
+#endif
+
+      MineSweeper::countAdjacent(*mines, actual.data());
+      EXPECT_TRUE(actual == expected);
+   }
+}
+
+TEST(MineSweeperAdjacency, kernels)
+{
+   checkKernels<9, 9>();
+   checkKernels<16, 16>();
+   checkKernels<30, 16>();
+   checkKernels<31, 3>();
+   checkKernels<32, 5>();
+   checkKernels<63, 4>();
+   checkKernels<64, 4>();
+   checkKernels<65, 4>();
+   checkKernels<100, 7>();
+   checkKernels<200, 50>();
+}
+
+TEST(MineSweeperAdjacency, board_value)
+{
+   MineSweeper::BitBoard<5, 5> mines;
+
+   // No mines, one opening
+   EXPECT_EQ(1u, MineSweeper::getBoardValue(mines));
+
+   // A mine in the centre leaves a ring shaped opening that reveals everything
+   mines.set(2, 2);
+   EXPECT_EQ(1u, MineSweeper::getBoardValue(mines));
+
+   // With a mine in the centre of a 3x3 board every safe plot is a click
+   MineSweeper::BitBoard<3, 3> small;
+   small.set(1, 1);
+   EXPECT_EQ(8u, MineSweeper::getBoardValue(small));
+
+   // Two mines split the board into two openings...
+   //
+   //    . . . . .
+   //    . . . . .
+   //    * * * * *
+   //    . . . . .
+   //    . . . . .
+   MineSweeper::BitBoard<5, 5> wall;
+   for(unsigned x = 0; x < 5; ++x) wall.set(x, 2);
+   EXPECT_EQ(2u, MineSweeper::getBoardValue(wall));
+}
@@ -0,0 +1,166 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 John D. Haughton
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//------------------------------------------------------------------------------
+
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "../MineSweeperBatch.h"
+
+#include "STB/Test.h"
+
+using Batch = MineSweeper::GameBatch<9, 9>;
+using Game  = MineSweeper::Game<9, 9>;
+
+//! Check every game in a batch against the matching single games
+static void expectSame(const Batch& batch, std::vector<std::unique_ptr<Game>>& games)
+{
+   for(unsigned i = 0; i < batch.size(); ++i)
+   {
+      const Game& game = *games[i];
+
+      EXPECT_EQ(game.getProgress(), batch.getProgress(i));
+      EXPECT_EQ(game.getNumberOfFlags(), batch.getNumberOfFlags(i));
+
+      for(unsigned y = 0; y < 9; ++y)
+      {
+         for(unsigned x = 0; x < 9; ++x)
+         {
+            bool game_mine;
+            bool batch_mine;
+
+            EXPECT_EQ(game.getPlotState(x, y, game_mine), batch.getPlotState(i, x, y, batch_mine));
+            EXPECT_EQ(game_mine, batch_mine);
+            EXPECT_EQ(game.getNumberOfAdjacentMines(x, y), batch.getNumberOfAdjacentMines(i, x, y));
+         }
+      }
+   }
+}
+
+static void playAlongside(MineSweeper::SafeZone safe_zone)
+{
+   // Not a whole number of blocks so the last block has spare lanes
+   const unsigned GAMES = 100;
+   const uint64_t SEED  = 7;
+
+   Batch                              batch{GAMES, /* num_of_mines */ 10, SEED, safe_zone};
+   std::vector<std::unique_ptr<Game>> games;
+
+   for(unsigned i = 0; i < GAMES; ++i)
+   {
+      games.emplace_back(new Game(/* num_of_mines */ 10));
+      games.back()->setSafeZone(safe_zone);
+      games.back()->reset(SEED + i);
+   }
+
+   expectSame(batch, games);
+
+   // Every game makes its first dig in the centre
+   batch.digHole(4, 4);
+   for(auto& game : games) game->digHole(4, 4);
+
+   expectSame(batch, games);
+
+   MineSweeper::Random   random{3};
+   std::vector<uint16_t> plots(GAMES);
+
+   for(unsigned step = 0; (step < 200) && (batch.getNumberInPlay() > 0); ++step)
+   {
+      if((step % 5) == 0)
+      {
+         unsigned x = random.below(9);
+         unsigned y = random.below(9);
+
+         batch.digHole(x, y);
+         for(auto& game : games) game->digHole(x, y);
+      }
+      else
+      {
+         for(unsigned i = 0; i < GAMES; ++i)
+         {
+            unsigned x = random.below(9);
+            unsigned y = random.below(9);
+
+            if(random.below(4) == 0)
+            {
+               batch.plantUnplantFlag(i, x, y);
+               games[i]->plantUnplantFlag(x, y);
+               plots[i] = Batch::NO_MOVE;
+            }
+            else
+            {
+               plots[i] = uint16_t(y * 9 + x);
+               games[i]->digHole(x, y);
+            }
+         }
+
+         batch.digHoles(plots.data());
+      }
+
+      expectSame(batch, games);
+   }
+
+   std::array<unsigned, 4> count = batch.countProgress();
+
+   EXPECT_EQ(GAMES, count[0] + count[1] + count[2] + count[3]);
+   EXPECT_EQ(batch.getNumberInPlay(), count[MineSweeper::RESET] + count[MineSweeper::CLEARING]);
+   EXPECT_TRUE(count[MineSweeper::DETONATED] > 0);
+}
+
+TEST(MineSweeperBatch, matches_game)
+{
+   playAlongside(MineSweeper::SAFE_PLOT);
+}
+
+TEST(MineSweeperBatch, matches_game_safe_neighbourhood)
+{
+   playAlongside(MineSweeper::SAFE_NEIGHBOURHOOD);
+}
+
+TEST(MineSweeperBatch, reset)
+{
+   Batch batch{/* games */ 40, /* num_of_mines */ 10};
+
+   batch.digHole(0, 0);
+   EXPECT_EQ(0u, batch.countProgress()[MineSweeper::RESET]);
+
+   batch.reset(/* seed */ 1);
+
+   EXPECT_EQ(40u, batch.countProgress()[MineSweeper::RESET]);
+   EXPECT_EQ(40u, batch.getNumberInPlay());
+
+   // Same seeds give the same layouts
+   Game game{/* num_of_mines */ 10, /* seed */ 1 + 39};
+
+   for(unsigned y = 0; y < 9; ++y)
+   {
+      for(unsigned x = 0; x < 9; ++x)
+      {
+         bool game_mine;
+         bool batch_mine;
+         game.getPlotState(x, y, game_mine);
+         batch.getPlotState(39, x, y, batch_mine);
+         EXPECT_EQ(game_mine, batch_mine);
+      }
+   }
+}
@@ -0,0 +1,84 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 John D. Haughton
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//------------------------------------------------------------------------------
+
+
+#include "../MineSweeperBitBoard.h"
+
+#include "STB/Test.h"
+
+TEST(MineSweeperBitBoard, word_size)
+{
+   EXPECT_EQ(sizeof(MineSweeper::BitBoard<9,9>),    9 * 2);
+   EXPECT_EQ(sizeof(MineSweeper::BitBoard<30,16>),  16 * 4);
+   EXPECT_EQ(sizeof(MineSweeper::BitBoard<100,10>), 10 * 2 * 8);
+}
+
+TEST(MineSweeperBitBoard, set_clear)
+{
+   MineSweeper::BitBoard<100,3> board;
+
+   EXPECT_FALSE(board.any());
+
+   board.set(0, 0);
+   board.set(63, 1);
+   board.set(64, 1);
+   board.set(99, 2);
+
+   EXPECT_TRUE(board.test(63, 1));
+   EXPECT_TRUE(board.test(64, 1));
+   EXPECT_FALSE(board.test(65, 1));
+   EXPECT_EQ(board.count(), 4);
+
+   board.clear(63, 1);
+   EXPECT_FALSE(board.test(63, 1));
+   EXPECT_EQ(board.count(), 3);
+
+   board.setAll();
+   EXPECT_EQ(board.count(), 300);
+
+   EXPECT_EQ((~board).count(), 0);
+}
+
+TEST(MineSweeperBitBoard, adjacent)
+{
+   MineSweeper::BitBoard<70,4> board;
+
+   // a bit either side of the first word boundary
+   board.set(63, 1);
+   board.set(64, 2);
+
+   EXPECT_EQ(board.countAdjacent(62, 0), 1);
+   EXPECT_EQ(board.countAdjacent(63, 1), 2);
+   EXPECT_EQ(board.countAdjacent(65, 3), 1);
+   EXPECT_EQ(board.countAdjacent(0, 0), 0);
+
+   MineSweeper::BitBoard<70,4> grown = board.dilate();
+
+   EXPECT_EQ(grown.count(), 9 + 9 - 4);
+   EXPECT_TRUE(grown.test(62, 0));
+   EXPECT_TRUE(grown.test(65, 3));
+   EXPECT_FALSE(grown.test(61, 1));
+
+   unsigned n = 0;
+   board.forEach([&](unsigned x, unsigned y){ n += x * y; });
+   EXPECT_EQ(n, 63 + 128);
+}
@@ -0,0 +1,133 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 John D. Haughton
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//------------------------------------------------------------------------------
+
+
+#include <cstdlib>
+#include <memory>
+
+#include "../MineSweeperDynamicGame.h"
+
+#include "STB/Test.h"
+
+static const unsigned WIDTH  = 16;
+static const unsigned HEIGHT = 16;
+static const unsigned MINES  = 40;
+
+using Reference = MineSweeper::Game<WIDTH,HEIGHT>;
+
+static bool sameState(const Reference& ref, const MineSweeper::DynamicGame& game)
+{
+   if((ref.getProgress() != game.getProgress()) ||
+      (ref.getNumberOfFlags() != game.getNumberOfFlags()))
+   {
+      return false;
+   }
+
+   for(unsigned y = 0; y < HEIGHT; ++y)
+   {
+      for(unsigned x = 0; x < WIDTH; ++x)
+      {
+         bool ref_mine, mine;
+
+         if((ref.getPlotState(x, y, ref_mine) != game.getPlotState(x, y, mine)) ||
+            (ref_mine != mine) ||
+            (ref.getNumberOfAdjacentMines(x, y) != game.getNumberOfAdjacentMines(x, y)))
+         {
+            return false;
+         }
+      }
+   }
+
+   return true;
+}
+
+TEST(MineSweeperDynamicGame, play)
+{
+   for(unsigned seed = 1; seed <= 20; ++seed)
+   {
+      // vary the safe zone as the re-plant must match too
+      MineSweeper::SafeZone zone = seed % 2 ? MineSweeper::SAFE_PLOT
+                                            : MineSweeper::SAFE_NEIGHBOURHOOD;
+
+      Reference ref{MINES, seed};
+      MineSweeper::DynamicGame game{WIDTH, HEIGHT, MINES, seed};
+
+      EXPECT_EQ(game.getWidth(), WIDTH);
+      EXPECT_EQ(game.getHeight(), HEIGHT);
+      ref.setSafeZone(zone);
+      game.setSafeZone(zone);
+
+      EXPECT_TRUE(sameState(ref, game));
+
+      for(unsigned move = 0; move < 200; ++move)
+      {
+         unsigned x = rand() % WIDTH;
+         unsigned y = rand() % HEIGHT;
+
+         if((move % 5) == 4)
+         {
+            ref.plantUnplantFlag(x, y);
+            game.plantUnplantFlag(x, y);
+         }
+         else
+         {
+            ref.digHole(x, y);
+            game.digHole(x, y);
+         }
+
+         EXPECT_TRUE(sameState(ref, game));
+      }
+   }
+}
+
+//! Clear a board that has a single mine
+template <typename GAME>
+static void clearOneMine(GAME& game, unsigned width, unsigned height)
+{
+   game.digHole(width / 2, height / 2);
+
+   for(unsigned y = 0; y < height; ++y)
+   {
+      for(unsigned x = 0; x < width; ++x)
+      {
+         bool mine;
+         game.getPlotState(x, y, mine);
+         if(mine)
+            game.plantUnplantFlag(x, y);
+         else
+            game.digHole(x, y);
+      }
+   }
+}
+
+TEST(MineSweeperDynamicGame, more_than_65535_plots)
+{
+   // Counts of holes overflowed 16-bit counters before
+   MineSweeper::DynamicGame game{400, 300, 1};
+   clearOneMine(game, 400, 300);
+   EXPECT_EQ(game.getProgress(), MineSweeper::CLEARED);
+
+   using BigGame = MineSweeper::Game<400,300>;
+   std::unique_ptr<BigGame> ref{new BigGame(1)};
+   clearOneMine(*ref, 400, 300);
+   EXPECT_EQ(ref->getProgress(), MineSweeper::CLEARED);
+}
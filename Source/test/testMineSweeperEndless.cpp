@@ -0,0 +1,323 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 John D. Haughton
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//------------------------------------------------------------------------------
+
+
+#include <memory>
+
+#include "../MineSweeperEndless.h"
+
+#include "STB/Test.h"
+
+using MineSweeper::EndlessGame;
+
+static const unsigned DENSITY = 20;
+
+//! Count the mines in the 3x3 window around a plot from the mine flags of the plots themselves
+static unsigned countAdjacent(const EndlessGame& game, int32_t x, int32_t y)
+{
+   unsigned n = 0;
+
+   for(int32_t dy = -1; dy <= 1; ++dy)
+   {
+      for(int32_t dx = -1; dx <= 1; ++dx)
+      {
+         bool mine;
+         game.getPlotState(x + dx, y + dy, mine);
+         n += mine;
+      }
+   }
+
+   return n;
+}
+
+//! Dig every safe plot in a window, as a player who knows the layout would
+static void digSafe(EndlessGame& game, int32_t x0, int32_t y0, int32_t w, int32_t h)
+{
+   for(int32_t y = y0; y < y0 + h; ++y)
+   {
+      for(int32_t x = x0; x < x0 + w; ++x)
+      {
+         bool mine;
+         if((game.getPlotState(x, y, mine) == MineSweeper::UNDUG) && !mine)
+         {
+            game.digHole(x, y);
+         }
+      }
+   }
+}
+
+TEST(MineSweeperEndless, first_dig_safe)
+{
+   for(uint64_t seed = 1; seed <= 50; ++seed)
+   {
+      EndlessGame game{DENSITY, seed};
+
+      EXPECT_EQ(MineSweeper::RESET, game.getProgress());
+
+      game.digHole(-1000, 7);
+
+      EXPECT_EQ(MineSweeper::CLEARING, game.getProgress());
+      EXPECT_EQ(0u, game.getNumberOfAdjacentMines(-1000, 7));
+      EXPECT_NE(0u, game.getNumberOfHoles());
+   }
+}
+
+TEST(MineSweeperEndless, layout_is_deterministic)
+{
+   EndlessGame a{DENSITY, 77};
+   EndlessGame b{DENSITY, 77};
+   EndlessGame c{DENSITY, 78};
+
+   a.digHole(5, 5);
+   b.digHole(5, 5);
+   c.digHole(5, 5);
+
+   unsigned differ = 0;
+
+   for(int32_t y = -100; y < 100; y += 3)
+   {
+      for(int32_t x = -100; x < 100; x += 3)
+      {
+         bool mine_a, mine_b, mine_c;
+         a.getPlotState(x, y, mine_a);
+         b.getPlotState(x, y, mine_b);
+         c.getPlotState(x, y, mine_c);
+
+         EXPECT_EQ(mine_a, mine_b);
+         differ += mine_a != mine_c;
+      }
+   }
+
+   EXPECT_NE(0u, differ);
+}
+
+TEST(MineSweeperEndless, density)
+{
+   EndlessGame game{DENSITY, 3};
+   game.digHole(0, 0);
+
+   unsigned mines = 0;
+
+   for(int32_t y = 0; y < 256; ++y)
+   {
+      for(int32_t x = 0; x < 256; ++x)
+      {
+         bool mine;
+         game.getPlotState(x, y, mine);
+         mines += mine;
+      }
+   }
+
+   // 20% of 65536 within a few percent
+   EXPECT_TRUE((mines > 12500) && (mines < 13700));
+}
+
+TEST(MineSweeperEndless, density_clamped)
+{
+   EndlessGame sparse{0, 1};
+   EndlessGame dense{150, 1};
+
+   EXPECT_EQ(unsigned(EndlessGame::MIN_DENSITY_PERCENT), sparse.getDensityPercent());
+   EXPECT_EQ(unsigned(EndlessGame::MAX_DENSITY_PERCENT), dense.getDensityPercent());
+   EXPECT_EQ(unsigned(DENSITY), EndlessGame(DENSITY, 1).getDensityPercent());
+
+   // The first dig on the sparsest field still ends
+   sparse.digHole(0, 0);
+   EXPECT_NE(0u, sparse.getNumberOfHoles());
+
+   // Almost every plot of the densest field is a mine
+   dense.digHole(0, 0);
+
+   unsigned mines = 0;
+
+   for(int32_t x = 10; x < 110; ++x)
+   {
+      bool mine;
+      dense.getPlotState(x, 10, mine);
+      mines += mine;
+   }
+
+   EXPECT_TRUE(mines > 90);
+}
+
+TEST(MineSweeperEndless, adjacency_across_chunks)
+{
+   EndlessGame game{DENSITY, 9};
+   game.digHole(1000, 1000);
+
+   const int32_t edges[] = {-65, -64, -63, -1, 0, 1, 63, 64, 65, 127, 128};
+
+   for(int32_t y : edges)
+   {
+      for(int32_t x : edges)
+      {
+         EXPECT_EQ(countAdjacent(game, x, y), game.getNumberOfAdjacentMines(x, y));
+      }
+   }
+}
+
+TEST(MineSweeperEndless, flood_fill_complete)
+{
+   for(uint64_t seed = 1; seed <= 20; ++seed)
+   {
+      // Near a chunk corner so the opening tends to cross chunk boundaries
+      EndlessGame game{DENSITY, seed};
+      game.digHole(63, -1);
+
+      unsigned zeros = 0;
+
+      for(int32_t y = -120; y < 120; ++y)
+      {
+         for(int32_t x = -60; x < 190; ++x)
+         {
+            bool mine;
+            if(game.getPlotState(x, y, mine) != MineSweeper::HOLE) continue;
+
+            EXPECT_FALSE(mine);
+
+            if(game.getNumberOfAdjacentMines(x, y) != 0) continue;
+
+            ++zeros;
+
+            // Every neighbour of an empty hole is dug
+            for(int32_t dy = -1; dy <= 1; ++dy)
+            {
+               for(int32_t dx = -1; dx <= 1; ++dx)
+               {
+                  EXPECT_EQ(MineSweeper::HOLE, game.getPlotState(x + dx, y + dy, mine));
+               }
+            }
+         }
+      }
+
+      EXPECT_NE(0u, zeros);
+   }
+}
+
+TEST(MineSweeperEndless, eviction_keeps_state)
+{
+   // Room for the minimum number of resident chunks only
+   EndlessGame small{DENSITY, 5, 0};
+   EndlessGame large{DENSITY, 5};
+
+   const int32_t spots[][2] = {{0, 0}, {500, 20}, {-300, 900}, {2000, -2000}, {10, 10},
+                               {-5000, -5000}, {640, 640}, {-64, 63}, {7000, 1}, {3, 3000}};
+
+   small.digHole(0, 0);
+   large.digHole(0, 0);
+
+   for(const auto& spot : spots)
+   {
+      digSafe(small, spot[0], spot[1], 3, 1);
+      digSafe(large, spot[0], spot[1], 3, 1);
+
+      small.plantUnplantFlag(spot[0] + 30, spot[1]);
+      large.plantUnplantFlag(spot[0] + 30, spot[1]);
+   }
+
+   // Resolve one chunk completely
+   digSafe(small, 128, 128, 64, 64);
+   digSafe(large, 128, 128, 64, 64);
+
+   // Touch enough new chunks to evict everything above
+   for(int32_t i = 1; i <= 20; ++i)
+   {
+      digSafe(small, i * 10000, 3, 4, 1);
+      digSafe(large, i * 10000, 3, 4, 1);
+   }
+
+   EXPECT_EQ(MineSweeper::CLEARING, small.getProgress());
+   EXPECT_NE(0u, small.getNumberOfEvictions());
+   EXPECT_NE(0u, small.getNumberOfCompactChunks());
+   EXPECT_NE(0u, small.getNumberOfResolvedChunks());
+   EXPECT_TRUE(small.getNumberOfResidentChunks() < large.getNumberOfResidentChunks());
+   EXPECT_TRUE(small.getMemoryBytes() < large.getMemoryBytes());
+
+   EXPECT_EQ(large.getNumberOfHoles(), small.getNumberOfHoles());
+   EXPECT_EQ(large.getNumberOfFlags(), small.getNumberOfFlags());
+
+   auto expectSame = [&](int32_t x0, int32_t y0)
+   {
+      for(int32_t y = y0 - 70; y < y0 + 70; y += 1)
+      {
+         for(int32_t x = x0 - 70; x < x0 + 70; x += 1)
+         {
+            bool mine_s, mine_l;
+            EXPECT_EQ(large.getPlotState(x, y, mine_l), small.getPlotState(x, y, mine_s));
+         }
+      }
+   };
+
+   for(const auto& spot : spots) expectSame(spot[0], spot[1]);
+   expectSame(160, 160);
+
+   // Evicted chunks come back as they were, including flags
+   small.plantUnplantFlag(30, 0);
+   large.plantUnplantFlag(30, 0);
+   EXPECT_EQ(large.getNumberOfFlags(), small.getNumberOfFlags());
+
+   expectSame(0, 0);
+}
+
+TEST(MineSweeperEndless, memory_cap_covers_evicted)
+{
+   const size_t  CAP  = 512 * 1024;
+   const int32_t BAND = 2 * EndlessGame::CHUNK_SIZE;
+
+   EndlessGame game{DENSITY, 1, CAP};
+   game.digHole(0, BAND / 2);
+
+   // Sweep a band well past the point where resident chunks alone fill the cap
+   digSafe(game, 0, 0, 100 * EndlessGame::CHUNK_SIZE, BAND);
+
+   EXPECT_NE(0u, game.getNumberOfResolvedChunks());
+   EXPECT_NE(0u, game.getNumberOfCompactChunks());
+
+   // Allow for the flood fill work stack
+   EXPECT_TRUE(game.getMemoryBytes() <= CAP + 64 * 1024);
+}
+
+TEST(MineSweeperEndless, detonate)
+{
+   EndlessGame game{DENSITY, 11};
+   game.digHole(0, 0);
+
+   // Find a mine away from the start
+   int32_t x = 10;
+   bool    mine = false;
+   while(game.getPlotState(x, 10, mine), !mine) ++x;
+
+   game.digHole(x, 10);
+
+   EXPECT_EQ(MineSweeper::DETONATED, game.getProgress());
+   EXPECT_EQ(MineSweeper::EXPLOSION, game.getPlotState(x, 10, mine));
+
+   // Nothing more can be dug
+   uint64_t holes = game.getNumberOfHoles();
+   digSafe(game, 20, 20, 10, 10);
+   EXPECT_EQ(holes, game.getNumberOfHoles());
+
+   game.reset(11);
+   EXPECT_EQ(MineSweeper::RESET, game.getProgress());
+   EXPECT_EQ(0u, game.getNumberOfHoles());
+   EXPECT_EQ(0u, game.getNumberOfResidentChunks());
+}
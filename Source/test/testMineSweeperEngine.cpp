@@ -0,0 +1,102 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 John D. Haughton
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//------------------------------------------------------------------------------
+
+
+#include <vector>
+
+#include "../MineSweeperEngine.h"
+
+#include "STB/Test.h"
+
+TEST(MineSweeperEngine, levels)
+{
+   EXPECT_FALSE(MineSweeper::Engine::isValidLevel(0));
+   EXPECT_TRUE(MineSweeper::Engine::isValidLevel(1));
+   EXPECT_TRUE(MineSweeper::Engine::isValidLevel(3));
+   EXPECT_FALSE(MineSweeper::Engine::isValidLevel(4));
+
+   MineSweeper::Engine expert{3};
+
+   EXPECT_EQ(30u, expert.getWidth());
+   EXPECT_EQ(16u, expert.getHeight());
+   EXPECT_EQ(99u, expert.getNumberOfFlags());
+   EXPECT_EQ(MineSweeper::RESET, expert.getProgress());
+}
+
+TEST(MineSweeperEngine, read_board_matches_game)
+{
+   const uint64_t seed = 42;
+
+   MineSweeper::Engine       engine{2, seed};
+   MineSweeper::Game<16, 16> game{40, seed};
+   std::vector<uint8_t>      board(engine.getNumberOfPlots());
+
+   // Too small a buffer writes nothing
+   EXPECT_EQ(0u, engine.readBoard(board.data(), board.size() - 1));
+
+   EXPECT_EQ(MineSweeper::CLEARING, engine.digHole(8, 8));
+   game.digHole(8, 8);
+
+   engine.plantUnplantFlag(0, 0);
+   game.plantUnplantFlag(0, 0);
+
+   EXPECT_EQ(board.size(), engine.readBoard(board.data(), board.size()));
+
+   for(unsigned y = 0; y < 16; ++y)
+   {
+      for(unsigned x = 0; x < 16; ++x)
+      {
+         EXPECT_EQ(game.getVisibleCode(x, y), board[y * 16 + x]);
+      }
+   }
+
+   EXPECT_EQ(MineSweeper::CODE_FLAG, board[0]);
+   EXPECT_EQ(game.getNumberOfFlags(), engine.getNumberOfFlags());
+}
+
+TEST(MineSweeperEngine, off_board_ignored)
+{
+   MineSweeper::Engine engine{1};
+
+   EXPECT_EQ(MineSweeper::RESET, engine.digHole(9, 0));
+   EXPECT_EQ(MineSweeper::RESET, engine.digHole(0, 1000));
+   EXPECT_EQ(MineSweeper::RESET, engine.plantUnplantFlag(100, 100));
+   EXPECT_EQ(10u, engine.getNumberOfFlags());
+}
+
+TEST(MineSweeperEngine, reset)
+{
+   MineSweeper::Engine engine{1};
+   std::vector<uint8_t> board(engine.getNumberOfPlots());
+
+   engine.digHole(4, 4);
+   engine.reset(7);
+
+   EXPECT_EQ(MineSweeper::RESET, engine.getProgress());
+
+   engine.readBoard(board.data(), board.size());
+
+   for(uint8_t code : board)
+   {
+      EXPECT_EQ(MineSweeper::CODE_UNDUG, code);
+   }
+}
@@ -0,0 +1,125 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 John D. Haughton
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//------------------------------------------------------------------------------
+
+
+
+#include "../MineSweeperFork.h"
+#include "../MineSweeperGame.h"
+
+#include "STB/Test.h"
+
+using Expert = MineSweeper::Game<30,16>;
+using Fork   = MineSweeper::GameFork<30,16>;
+
+template <typename A, typename B>
+static bool sameState(const A& a, const B& b)
+{
+   if((a.getProgress() != b.getProgress()) || (a.getNumberOfFlags() != b.getNumberOfFlags()) ||
+      (a.getNumberOfTicks() != b.getNumberOfTicks()))
+   {
+      return false;
+   }
+
+   for(unsigned y = 0; y < 16; ++y)
+   {
+      for(unsigned x = 0; x < 30; ++x)
+      {
+         bool mine_a, mine_b;
+         if(a.getPlotState(x, y, mine_a) != b.getPlotState(x, y, mine_b)) return false;
+         if(mine_a != mine_b) return false;
+         if(a.getNumberOfAdjacentMines(x, y) != b.getNumberOfAdjacentMines(x, y)) return false;
+      }
+   }
+
+   return true;
+}
+
+TEST(MineSweeperFork, plays_like_game)
+{
+   MineSweeper::Random random(3);
+
+   for(uint64_t seed = 1; seed <= 50; ++seed)
+   {
+      Expert game(99, seed);
+      game.digHole(random.below(30), random.below(16));
+
+      Fork fork(game);
+      EXPECT_TRUE(sameState(game, fork));
+
+      while(game.getProgress() == MineSweeper::CLEARING)
+      {
+         unsigned x = random.below(30);
+         unsigned y = random.below(16);
+
+         switch(random.below(4))
+         {
+         case 0:
+            game.plantUnplantFlag(x, y);
+            fork.plantUnplantFlag(x, y);
+            break;
+
+         case 1:
+            game.tick();
+            fork.tick();
+            break;
+
+         default:
+            game.digHole(x, y);
+            fork.digHole(x, y);
+            break;
+         }
+
+         EXPECT_TRUE(sameState(game, fork));
+      }
+   }
+}
+
+TEST(MineSweeperFork, copies_are_independent)
+{
+   Expert game(99, 7);
+   game.digHole(15, 8);
+
+   Fork original(game);
+   Fork copy = original;
+
+   // Clear the board in the copy
+   for(unsigned y = 0; y < 16; ++y)
+   {
+      for(unsigned x = 0; x < 30; ++x)
+      {
+         bool mine;
+         copy.getPlotState(x, y, mine);
+         if(mine)
+            copy.plantUnplantFlag(x, y);
+         else
+            copy.digHole(x, y);
+      }
+   }
+
+   EXPECT_EQ(MineSweeper::CLEARED, copy.getProgress());
+   EXPECT_EQ(MineSweeper::CLEARING, original.getProgress());
+   EXPECT_TRUE(sameState(game, original));
+
+   // Restore by assignment
+   copy = original;
+   EXPECT_TRUE(sameState(game, copy));
+}
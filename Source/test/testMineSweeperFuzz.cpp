@@ -0,0 +1,148 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 John D. Haughton
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//------------------------------------------------------------------------------
+
+
+#include "../MineSweeperFuzz.h"
+
+#include "STB/Test.h"
+
+using namespace MineSweeper;
+
+//! DynamicGame with a planted bug, the flag count is wrong after a third flag
+template <unsigned WIDTH, unsigned HEIGHT>
+class BrokenSubject : public Fuzz::DynamicSubject<WIDTH, HEIGHT>
+{
+public:
+   static const char* getName() { return "Broken"; }
+
+   BrokenSubject(const Fuzz::Case& c)
+      : Fuzz::DynamicSubject<WIDTH, HEIGHT>(c)
+   {
+   }
+
+   void apply(const Move& move)
+   {
+      Fuzz::DynamicSubject<WIDTH, HEIGHT>::apply(move);
+
+      if(move.type == Move::FLAG) ++flag_moves;
+   }
+
+   unsigned getNumberOfFlags() const
+   {
+      return Fuzz::DynamicSubject<WIDTH, HEIGHT>::getNumberOfFlags() + (flag_moves >= 3);
+   }
+
+private:
+   unsigned flag_moves{0};
+};
+
+template <unsigned WIDTH, unsigned HEIGHT>
+static void expectEnginesAgree(uint64_t seed)
+{
+   Random random{seed};
+
+   for(unsigned i = 0; i < 20; ++i)
+   {
+      Fuzz::Case c = Fuzz::makeCase<WIDTH, HEIGHT>(random);
+
+      EXPECT_EQ(Fuzz::NO_FAILURE, (Fuzz::findFailure<Fuzz::PackedSubject, WIDTH, HEIGHT>(c)));
+      EXPECT_EQ(Fuzz::NO_FAILURE, (Fuzz::findFailure<Fuzz::DynamicSubject, WIDTH, HEIGHT>(c)));
+      EXPECT_EQ(Fuzz::NO_FAILURE, (Fuzz::findFailure<Fuzz::BatchSubject, WIDTH, HEIGHT>(c)));
+      EXPECT_EQ(Fuzz::NO_FAILURE, (Fuzz::findFailure<Fuzz::MovesSubject, WIDTH, HEIGHT>(c)));
+   }
+}
+
+TEST(MineSweeperFuzz, engines_agree)
+{
+   expectEnginesAgree<9, 9>(1);
+   expectEnginesAgree<16, 16>(2);
+   expectEnginesAgree<30, 16>(3);
+   expectEnginesAgree<8, 3>(4);
+}
+
+TEST(MineSweeperFuzz, cases_reach_the_end_game)
+{
+   Random   random{5};
+   unsigned ended = 0;
+
+   for(unsigned i = 0; i < 100; ++i)
+   {
+      Fuzz::Case c = Fuzz::makeCase<9, 9>(random);
+
+      Game<9, 9> game{c.mines, c.seed};
+      game.setSafeZone(c.zone);
+      game.applyMoves(c.moves.data(), c.moves.size());
+
+      ended += game.getProgress() >= DETONATED;
+   }
+
+   EXPECT_TRUE(ended > 50);
+}
+
+TEST(MineSweeperFuzz, finds_and_shrinks)
+{
+   Random random{6};
+
+   // Find a case long enough to show the bug
+   Fuzz::Case c;
+   do
+   {
+      c = Fuzz::makeCase<16, 16>(random);
+   }
+   while(Fuzz::findFailure<BrokenSubject, 16, 16>(c) == Fuzz::NO_FAILURE);
+
+   std::string what;
+   EXPECT_NE(0u, (Fuzz::findFailure<BrokenSubject, 16, 16>(c, &what)));
+   EXPECT_EQ(0u, what.find("flags"));
+
+   Fuzz::Case minimal = Fuzz::shrink<BrokenSubject, 16, 16>(c);
+
+   EXPECT_NE(Fuzz::NO_FAILURE, (Fuzz::findFailure<BrokenSubject, 16, 16>(minimal)));
+   EXPECT_TRUE(minimal.moves.size() <= c.moves.size());
+
+   // Just the three flag moves
+   EXPECT_EQ(3u, minimal.moves.size());
+   for(const Move& move : minimal.moves)
+   {
+      EXPECT_EQ(Move::FLAG, move.type);
+   }
+
+   // No single move can be removed
+   for(size_t i = 0; i < minimal.moves.size(); ++i)
+   {
+      Fuzz::Case fewer = minimal;
+      fewer.moves.erase(fewer.moves.begin() + i);
+
+      EXPECT_EQ(Fuzz::NO_FAILURE, (Fuzz::findFailure<BrokenSubject, 16, 16>(fewer)));
+   }
+}
+
+TEST(MineSweeperFuzz, runner)
+{
+   Fuzz::Runner runner{2};
+
+   Fuzz::Result result = runner.run(/* seconds */ 0.2, /* seed */ 7);
+
+   EXPECT_FALSE(result.failed);
+   EXPECT_NE(0u, result.cases);
+   EXPECT_NE(0u, result.moves);
+}
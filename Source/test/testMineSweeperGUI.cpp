@@ -20,6 +20,8 @@
 // SOFTWARE.
 //------------------------------------------------------------------------------
 
+#include <memory>
+
 #include "../MineSweeperGUI.h"
 
 #include "STB/Test.h"
@@ -30,3 +32,96 @@ TEST(MineSweeperGUI, constructor)
 
    (void) gui;
 }
+
+TEST(MineSweeperGUI, constructor_large)
+{
+   auto gui = std::make_unique<MineSweeperGUI<120,80>>(1500);
+
+   (void) gui;
+}
+
+TEST(MineSweeperGUI, plot_code)
+{
+   using Minefield = MinefieldWidget<MineSweeper::Game<16384,16384>>;
+
+   for(unsigned y = 0; y < 16384; y += 1021)
+   {
+      for(unsigned x = 0; x < 16384; x += 509)
+      {
+         unsigned code = Minefield::getPlotCode(x, y);
+
+         unsigned dx, dy;
+         Minefield::decodePlot(code, dx, dy);
+
+         EXPECT_EQ(x, dx);
+         EXPECT_EQ(y, dy);
+      }
+   }
+}
+
+using Hook = MineSweeperGUITestHook;
+
+//! Number of plots the minefield view visits
+template <typename FIELD>
+static unsigned countVisible(const FIELD& field)
+{
+   unsigned n = 0;
+   field.forEachVisiblePlot([&n](unsigned, unsigned){ ++n; });
+   return n;
+}
+
+TEST(MineSweeperGUI, small_board_not_scrollable)
+{
+   MineSweeperGUI<30,16> gui(99);
+
+   auto& field = Hook::getField(gui);
+
+   EXPECT_FALSE(field.isScrollable());
+   EXPECT_EQ(30u * 16u, countVisible(field));
+}
+
+TEST(MineSweeperGUI, viewport)
+{
+   auto  gui   = std::make_unique<MineSweeperGUI<2000,1500>>(1000);
+   auto& field = Hook::getField(*gui);
+
+   EXPECT_TRUE(field.isScrollable());
+
+   // Only the plots in the view are visited
+   unsigned visible = countVisible(field);
+   EXPECT_TRUE(visible <= 41u * 25u);
+
+   unsigned size = field.getPlotSize();
+
+   // Partly visible plots at the edges add at most a row and a column
+   field.scrollTo(1000, 750);
+   EXPECT_TRUE(countVisible(field) <= 41u * 25u);
+
+   unsigned x, y;
+   field.getCentrePlot(x, y);
+   EXPECT_EQ(1000u, x);
+   EXPECT_EQ(750u, y);
+
+   // Zooming out shows more plots and keeps the centre
+   field.zoomBy(-1);
+   EXPECT_TRUE(field.getPlotSize() < size);
+   EXPECT_TRUE(countVisible(field) > visible);
+
+   field.getCentrePlot(x, y);
+   EXPECT_EQ(1000u, x);
+   EXPECT_EQ(750u, y);
+
+   // And zooming back in
+   field.zoomBy(+1);
+   EXPECT_EQ(size, field.getPlotSize());
+
+   field.getCentrePlot(x, y);
+   EXPECT_EQ(1000u, x);
+   EXPECT_EQ(750u, y);
+
+   // Scrolling is clamped to the board
+   field.scrollBy(-1000000, -1000000);
+   field.scrollBy(+1000000, +1000000);
+   field.scrollTo(1999, 1499);
+   EXPECT_TRUE(countVisible(field) > 0u);
+}
@@ -20,10 +20,40 @@
 // SOFTWARE.
 //------------------------------------------------------------------------------
 
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
 #include "../MineSweeperGame.h"
 
 #include "STB/Test.h"
 
+// Count heap allocations so tests can check that a path does not allocate
+
+static std::atomic<unsigned> allocations{0};
+
+void* operator new(size_t size)
+{
+   ++allocations;
+
+   void* ptr = malloc(size == 0 ? 1 : size);
+   if(ptr == nullptr) throw std::bad_alloc();
+   return ptr;
+}
+
+void* operator new[](size_t size)
+{
+   return operator new(size);
+}
+
+void operator delete(void* ptr) noexcept { free(ptr); }
+void operator delete[](void* ptr) noexcept { free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { free(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { free(ptr); }
+
 static const size_t WIDTH  = 10;
 static const size_t HEIGHT = 10;
 static const size_t MINES  = 10;
@@ -91,6 +121,533 @@ TEST(MineSweeperGame, constructor)
    }
 }
 
+TEST(MineSweeperGame, flood_fill)
+{
+   // Big enough to overflow the stack if the flood fill were recursive
+   using BigGame = MineSweeper::Game<250,250>;
+
+   std::unique_ptr<BigGame> game{new BigGame(/* num_of_mines */ 1)};
+
+   game->digHole(0, 0);
+
+   EXPECT_EQ(game->getProgress(), MineSweeper::CLEARING);
+
+   size_t num_of_holes = 0;
+
+   for(size_t y=0; y<250; ++y)
+   {
+      for(size_t x=0; x<250; ++x)
+      {
+         bool mine;
+         if (game->getPlotState(x, y, mine) == MineSweeper::HOLE)
+         {
+            EXPECT_FALSE(mine);
+            ++num_of_holes;
+         }
+      }
+   }
+
+   EXPECT_EQ(num_of_holes, 250 * 250 - 1);
+}
+
+//! Check adjacent counts and the first flood fill against a brute force scan with bounds checks
+template <unsigned W, unsigned H>
+static void expectNeighboursMatchReference(unsigned mines)
+{
+   MineSweeper::Game<W,H> game{mines};
+   MineSweeper::Random    random{9};
+
+   for(uint64_t seed = 1; seed <= 100; ++seed)
+   {
+      // Start from corners, edges and the interior in turn
+      unsigned start_x = seed % 3 == 0 ? 0 : seed % 3 == 1 ? W - 1 : random.below(W);
+      unsigned start_y = seed % 5 == 0 ? 0 : seed % 5 == 1 ? H - 1 : random.below(H);
+
+      game.reset(seed);
+      game.digHole(start_x, start_y);
+
+      std::vector<bool>     mined(W * H);
+      std::vector<unsigned> count(W * H);
+
+      for(unsigned i = 0; i < W * H; ++i)
+      {
+         bool mine;
+         game.getPlotState(i % W, i / W, mine);
+         mined[i] = mine;
+      }
+
+      for(signed y = 0; y < signed(H); ++y)
+      {
+         for(signed x = 0; x < signed(W); ++x)
+         {
+            for(signed scan_y = y - 1; scan_y <= y + 1; ++scan_y)
+               for(signed scan_x = x - 1; scan_x <= x + 1; ++scan_x)
+                  if((scan_x >= 0) && (scan_x < signed(W)) && (scan_y >= 0) && (scan_y < signed(H)))
+                     count[y * W + x] += mined[scan_y * W + scan_x];
+
+            EXPECT_EQ(count[y * W + x], game.getNumberOfAdjacentMines(x, y));
+         }
+      }
+
+      std::vector<bool>     dug(W * H);
+      std::vector<unsigned> stack{start_y * W + start_x};
+
+      dug[stack.back()] = true;
+
+      while(!stack.empty())
+      {
+         unsigned i = stack.back();
+         stack.pop_back();
+
+         if(count[i] != 0) continue;
+
+         for(signed scan_y = signed(i / W) - 1; scan_y <= signed(i / W) + 1; ++scan_y)
+         {
+            for(signed scan_x = signed(i % W) - 1; scan_x <= signed(i % W) + 1; ++scan_x)
+            {
+               if((scan_x < 0) || (scan_x >= signed(W)) || (scan_y < 0) || (scan_y >= signed(H))) continue;
+
+               unsigned j = scan_y * W + scan_x;
+               if(!dug[j] && !mined[j])
+               {
+                  dug[j] = true;
+                  stack.push_back(j);
+               }
+            }
+         }
+      }
+
+      for(unsigned i = 0; i < W * H; ++i)
+      {
+         bool mine;
+         EXPECT_EQ(dug[i], game.getPlotState(i % W, i / W, mine) == MineSweeper::HOLE);
+      }
+   }
+}
+
+TEST(MineSweeperGame, neighbours_match_reference)
+{
+   expectNeighboursMatchReference<9,9>(10);
+   expectNeighboursMatchReference<30,16>(99);
+   expectNeighboursMatchReference<30,16>(10);
+}
+
+TEST(MineSweeperGame, changes)
+{
+   MineSweeper::Game<WIDTH,HEIGHT>  game{/* num_of_mines */ MINES};
+
+   // Everything has changed after a reset
+   size_t num_of_changes = 0;
+   game.forEachChangedPlot([&](unsigned, unsigned){ ++num_of_changes; });
+   EXPECT_EQ(num_of_changes, WIDTH * HEIGHT);
+
+   num_of_changes = 0;
+   game.forEachChangedPlot([&](unsigned, unsigned){ ++num_of_changes; });
+   EXPECT_EQ(num_of_changes, 0);
+
+   // Only the holes dug have changed
+   game.digHole(0, 0);
+
+   game.forEachChangedPlot([&](unsigned x, unsigned y)
+   {
+      bool mine;
+      EXPECT_EQ(game.getPlotState(x, y, mine), MineSweeper::HOLE);
+      ++num_of_changes;
+   });
+
+   EXPECT_NE(num_of_changes, 0);
+
+   // Timer ticks change no plots
+   game.tick();
+   num_of_changes = 0;
+   game.forEachChangedPlot([&](unsigned, unsigned){ ++num_of_changes; });
+   EXPECT_EQ(num_of_changes, 0);
+}
+
+TEST(MineSweeperGame, number_of_changes)
+{
+   MineSweeper::Game<WIDTH,HEIGHT>  game{/* num_of_mines */ MINES};
+   game.enableHistory(4096);
+
+   uint32_t last = game.getNumberOfChanges();
+
+   // Ticks change nothing
+   game.tick();
+   EXPECT_EQ(last, game.getNumberOfChanges());
+
+   game.digHole(0, 0);
+   EXPECT_NE(last, game.getNumberOfChanges());
+   last = game.getNumberOfChanges();
+
+   // Digging a hole twice changes nothing
+   game.digHole(0, 0);
+   EXPECT_EQ(last, game.getNumberOfChanges());
+
+   game.undo();
+   EXPECT_NE(last, game.getNumberOfChanges());
+   last = game.getNumberOfChanges();
+
+   game.reset();
+   EXPECT_NE(last, game.getNumberOfChanges());
+}
+
+TEST(MineSweeperGame, snapshot)
+{
+   using Game = MineSweeper::Game<WIDTH,HEIGHT>;
+
+   static_assert(std::is_trivially_copyable<Game::Snapshot>::value, "Snapshot must be a plain blob");
+
+   Game game{/* num_of_mines */ MINES, /* seed */ 5};
+
+   game.digHole(5, 5);
+   game.tick();
+
+   // Flag the first undug plot
+   for(size_t i = 0; i < WIDTH * HEIGHT; ++i)
+   {
+      bool mine;
+      if (game.getPlotState(i % WIDTH, i / WIDTH, mine) == MineSweeper::UNDUG)
+      {
+         game.plantUnplantFlag(i % WIDTH, i / WIDTH);
+         break;
+      }
+   }
+
+   Game::Snapshot snapshot;
+   game.save(snapshot);
+
+   Game copy{/* num_of_mines */ 1};
+   copy.restore(snapshot);
+
+   EXPECT_EQ(copy.getProgress(), game.getProgress());
+   EXPECT_EQ(copy.getNumberOfFlags(), game.getNumberOfFlags());
+   EXPECT_EQ(copy.getNumberOfTicks(), game.getNumberOfTicks());
+
+   for(size_t y=0; y<HEIGHT; ++y)
+   {
+      for(size_t x=0; x<WIDTH; ++x)
+      {
+         bool mine, copy_mine;
+         EXPECT_EQ(copy.getPlotState(x, y, copy_mine), game.getPlotState(x, y, mine));
+         EXPECT_EQ(copy_mine, mine);
+         EXPECT_EQ(copy.getNumberOfAdjacentMines(x, y), game.getNumberOfAdjacentMines(x, y));
+      }
+   }
+
+   // Both continue identically, including the layout of the next game
+   game.reset();
+   copy.reset();
+
+   for(size_t y=0; y<HEIGHT; ++y)
+   {
+      for(size_t x=0; x<WIDTH; ++x)
+      {
+         bool mine, copy_mine;
+         game.getPlotState(x, y, mine);
+         copy.getPlotState(x, y, copy_mine);
+         EXPECT_EQ(copy_mine, mine);
+      }
+   }
+}
+
+TEST(MineSweeperGame, undo_redo)
+{
+   using Game = MineSweeper::Game<WIDTH,HEIGHT>;
+
+   // Visible state and counters of a game
+   auto visible = [](const Game& game)
+   {
+      std::vector<unsigned> state;
+
+      state.push_back(game.getProgress());
+      state.push_back(game.getNumberOfFlags());
+
+      for(size_t y=0; y<HEIGHT; ++y)
+      {
+         for(size_t x=0; x<WIDTH; ++x)
+         {
+            bool mine;
+            state.push_back(game.getPlotState(x, y, mine));
+         }
+      }
+
+      return state;
+   };
+
+   MineSweeper::Random random{11};
+
+   for(uint64_t seed = 1; seed <= 20; ++seed)
+   {
+      Game game{/* num_of_mines */ MINES, seed};
+      game.enableHistory(1 << 20);
+
+      EXPECT_FALSE(game.canUndo());
+      EXPECT_FALSE(game.undo());
+
+      std::vector<std::vector<unsigned>> states;
+      states.push_back(visible(game));
+
+      while((game.getProgress() == MineSweeper::RESET) || (game.getProgress() == MineSweeper::CLEARING))
+      {
+         unsigned x = random.below(WIDTH);
+         unsigned y = random.below(HEIGHT);
+
+         if(random.below(3) == 0)
+            game.plantUnplantFlag(x, y);
+         else
+            game.digHole(x, y);
+
+         // Moves that change nothing are not recorded
+         if(visible(game) != states.back()) states.push_back(visible(game));
+      }
+
+      for(size_t i = states.size() - 1; i-- > 0;)
+      {
+         EXPECT_TRUE(game.undo());
+         EXPECT_TRUE(visible(game) == states[i]);
+      }
+
+      EXPECT_FALSE(game.undo());
+
+      for(size_t i = 1; i < states.size(); ++i)
+      {
+         EXPECT_TRUE(game.redo());
+         EXPECT_TRUE(visible(game) == states[i]);
+      }
+
+      EXPECT_FALSE(game.redo());
+
+      // A new move after an undo discards the redo history
+      game.undo();
+      EXPECT_TRUE(game.canRedo());
+
+      if(game.getProgress() == MineSweeper::CLEARING)
+      {
+         for(size_t i = 0; i < WIDTH * HEIGHT; ++i)
+         {
+            bool mine;
+            if(game.getPlotState(i % WIDTH, i / WIDTH, mine) == MineSweeper::UNDUG)
+            {
+               game.plantUnplantFlag(i % WIDTH, i / WIDTH);
+               break;
+            }
+         }
+
+         EXPECT_FALSE(game.canRedo());
+      }
+   }
+}
+
+TEST(MineSweeperGame, undo_is_compact)
+{
+   using BigGame = MineSweeper::Game<250,250>;
+
+   std::unique_ptr<BigGame> game{new BigGame(/* num_of_mines */ 2)};
+   game->enableHistory(/* bytes */ 4096);
+
+   // Opens most of the board as runs along each row
+   game->digHole(0, 0);
+   EXPECT_TRUE(game->getHistoryBytes() < 2048);
+
+   // The oldest moves are dropped to stay within the budget
+   size_t mine_x = 0;
+   size_t mine_y = 0;
+
+   for(size_t y=0; y<250; ++y)
+   {
+      for(size_t x=0; x<250; ++x)
+      {
+         bool mine;
+         if (game->getPlotState(x, y, mine) == MineSweeper::UNDUG)
+         {
+            mine_x = x;
+            mine_y = y;
+         }
+      }
+   }
+
+   for(unsigned i = 0; i < 1000; ++i)
+   {
+      game->plantUnplantFlag(mine_x, mine_y);
+   }
+
+   EXPECT_TRUE(game->getHistoryBytes() <= 4096);
+
+   unsigned undone = 0;
+   while(game->undo()) ++undone;
+
+   EXPECT_TRUE((undone > 0) && (undone < 1000));
+
+   game->enableHistory(0);
+   EXPECT_FALSE(game->canUndo());
+}
+
+TEST(MineSweeperGame, copy_without_history)
+{
+   using Game = MineSweeper::Game<9,9>;
+
+   Game game{/* num_of_mines */ 10};
+   game.digHole(4, 4);
+
+   // Nothing to deep copy while the history is disabled
+   unsigned before = allocations;
+   Game copy{game};
+   EXPECT_EQ(before, unsigned(allocations));
+
+   bool mine;
+   EXPECT_EQ(game.getPlotState(4, 4, mine), copy.getPlotState(4, 4, mine));
+
+   // An enabled history is copied, not shared
+   game.enableHistory(4096);
+   game.plantUnplantFlag(0, 0);
+
+   Game with_history{game};
+   EXPECT_TRUE(with_history.undo());
+   EXPECT_TRUE(game.canUndo());
+}
+
+TEST(MineSweeperGame, apply_moves)
+{
+   using Game = MineSweeper::Game<WIDTH,HEIGHT>;
+   using Move = MineSweeper::Move;
+
+   // Visible state and counters of a game
+   auto visible = [](const Game& game)
+   {
+      std::vector<unsigned> state;
+
+      state.push_back(game.getProgress());
+      state.push_back(game.getNumberOfFlags());
+
+      for(size_t y=0; y<HEIGHT; ++y)
+      {
+         for(size_t x=0; x<WIDTH; ++x)
+         {
+            bool mine;
+            state.push_back(game.getPlotState(x, y, mine));
+         }
+      }
+
+      return state;
+   };
+
+   MineSweeper::Random random{5};
+
+   for(uint64_t seed = 1; seed <= 100; ++seed)
+   {
+      Game single{/* num_of_mines */ MINES, seed};
+      Game batch{/* num_of_mines */ MINES, seed};
+      batch.enableHistory(1 << 16);
+
+      std::vector<Move> moves;
+
+      auto randomMove = [&]()
+      {
+         Move::Type type = random.below(3) == 0 ? Move::FLAG : Move::DIG;
+         moves.push_back({uint16_t(random.below(WIDTH)), uint16_t(random.below(HEIGHT)), type});
+      };
+
+      // A flag before the first dig is ignored
+      moves.push_back({0, 0, Move::FLAG});
+      moves.push_back({uint16_t(random.below(WIDTH)), uint16_t(random.below(HEIGHT)), Move::DIG});
+
+      // Lay the mines, following the moves so that half the batches can end
+      // by digging every safe plot and flagging every mine
+      Game layout{/* num_of_mines */ MINES, seed};
+      layout.digHole(moves.back().x, moves.back().y);
+
+      for(unsigned i = 0; i < 20; ++i)
+      {
+         randomMove();
+
+         if(moves.back().type == Move::DIG)
+            layout.digHole(moves.back().x, moves.back().y);
+         else
+            layout.plantUnplantFlag(moves.back().x, moves.back().y);
+      }
+
+      if((seed % 2) == 0)
+      {
+         for(bool flag_mines : {false, true})
+         {
+            for(uint16_t y=0; y<HEIGHT; ++y)
+            {
+               for(uint16_t x=0; x<WIDTH; ++x)
+               {
+                  bool mine;
+                  MineSweeper::State state = layout.getPlotState(x, y, mine);
+
+                  if(mine != flag_mines) continue;
+
+                  if(mine)
+                  {
+                     if(state == MineSweeper::UNDUG) moves.push_back({x, y, Move::FLAG});
+                  }
+                  else
+                  {
+                     if(state == MineSweeper::FLAG) moves.push_back({x, y, Move::FLAG});
+                     moves.push_back({x, y, Move::DIG});
+                  }
+               }
+            }
+         }
+      }
+
+      // Once cleared, removing a flag must not change the board
+      for(unsigned i = 0; i < 20; ++i) randomMove();
+
+      size_t ended = moves.size();
+
+      for(size_t i = 0; i < moves.size(); ++i)
+      {
+         if(moves[i].type == Move::DIG)
+            single.digHole(moves[i].x, moves[i].y);
+         else
+            single.plantUnplantFlag(moves[i].x, moves[i].y);
+
+         if((single.getProgress() == MineSweeper::DETONATED) && (ended == moves.size()))
+         {
+            ended = i + 1;
+         }
+      }
+
+      std::vector<unsigned> before = visible(batch);
+
+      MineSweeper::MoveSummary summary = batch.applyMoves(moves.data(), moves.size());
+
+      EXPECT_TRUE(visible(batch) == visible(single));
+      EXPECT_EQ(summary.progress, single.getProgress());
+      unsigned holes = 0;
+      for(size_t i = 0; i < WIDTH * HEIGHT; ++i)
+      {
+         bool mine;
+         if((single.getPlotState(i % WIDTH, i / WIDTH, mine) == MineSweeper::HOLE) && !mine) ++holes;
+      }
+
+      EXPECT_EQ(summary.holes, holes);
+      EXPECT_EQ(summary.flags, signed(MINES) - signed(single.getNumberOfFlags()));
+
+      if(single.getProgress() == MineSweeper::DETONATED)
+      {
+         EXPECT_EQ(summary.applied, ended);
+      }
+      else if(single.getProgress() == MineSweeper::CLEARING)
+      {
+         EXPECT_EQ(summary.applied, moves.size());
+      }
+
+      if((seed % 2) == 0)
+      {
+         EXPECT_NE(single.getProgress(), MineSweeper::CLEARING);
+      }
+
+      // The whole batch is a single step of history
+      EXPECT_TRUE(batch.undo());
+      EXPECT_TRUE(visible(batch) == before);
+      EXPECT_FALSE(batch.undo());
+   }
+}
+
 TEST(MineSweeperGame, play)
 {
    // TODO
@@ -0,0 +1,140 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 John D. Haughton
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//------------------------------------------------------------------------------
+
+
+#include "../MineSweeperGenerator.h"
+
+#include "STB/Test.h"
+
+using Intermediate = MineSweeper::Game<16,16>;
+
+TEST(MineSweeperGenerator, queue_is_fifo_and_bounded)
+{
+   MineSweeper::BoundedQueue<unsigned> queue(3);
+
+   for(unsigned i = 0; i < 4; ++i)
+   {
+      EXPECT_TRUE(queue.push(i));
+   }
+
+   EXPECT_FALSE(queue.push(4));
+   EXPECT_EQ(4u, queue.size());
+
+   for(unsigned i = 0; i < 4; ++i)
+   {
+      unsigned item;
+      EXPECT_TRUE(queue.pop(item));
+      EXPECT_EQ(i, item);
+   }
+
+   unsigned item;
+   EXPECT_FALSE(queue.pop(item));
+}
+
+TEST(MineSweeperGenerator, queue_minimum_capacity)
+{
+   MineSweeper::BoundedQueue<unsigned> queue(1);
+
+   EXPECT_TRUE(queue.push(1));
+   EXPECT_TRUE(queue.push(2));
+   EXPECT_FALSE(queue.push(3));
+
+   unsigned item;
+   EXPECT_TRUE(queue.pop(item));
+   EXPECT_EQ(1u, item);
+}
+
+TEST(MineSweeperGenerator, queue_concurrent)
+{
+   MineSweeper::BoundedQueue<unsigned> queue(16);
+   std::atomic<uint64_t>               total{0};
+   const unsigned                      N = 10000;
+
+   std::vector<std::thread> thread;
+
+   for(unsigned t = 0; t < 2; ++t)
+   {
+      thread.emplace_back([&]{ for(unsigned i = 1; i <= N; ++i) while(!queue.push(i)) std::this_thread::yield(); });
+      thread.emplace_back([&]{ for(unsigned i = 1; i <= N; ++i)
+                               {
+                                  unsigned item;
+                                  while(!queue.pop(item)) std::this_thread::yield();
+                                  total += item;
+                               } });
+   }
+
+   for(auto& t : thread) t.join();
+
+   EXPECT_EQ(uint64_t(N) * (N + 1), total.load());
+}
+
+TEST(MineSweeperGenerator, layouts_need_no_guessing)
+{
+   MineSweeper::NoGuessGenerator<16,16> generator(40, 2, 8, 1234);
+   MineSweeper::Solver<16,16>           solver;
+   Intermediate                         game(40);
+
+   for(unsigned i = 0; i < 10; ++i)
+   {
+      EXPECT_TRUE(generator.reset(game));
+
+      EXPECT_EQ(40u, game.getNumberOfFlags());
+      EXPECT_EQ(MineSweeper::CLEARING, game.getProgress());
+
+      solver.play(game);
+
+      EXPECT_EQ(MineSweeper::CLEARED, game.getProgress());
+   }
+}
+
+TEST(MineSweeperGenerator, on_demand_without_workers)
+{
+   MineSweeper::NoGuessGenerator<9,9> generator(10, 1, 1, 99);
+
+   // drain faster than the single worker can fill
+   for(unsigned i = 0; i < 5; ++i)
+   {
+      MineSweeper::Layout<9,9> layout = generator.getLayout();
+
+      EXPECT_EQ(10u, layout.mines.count());
+      EXPECT_FALSE(layout.mines.test(layout.start_x, layout.start_y));
+      EXPECT_TRUE(layout.no_guess);
+   }
+}
+
+TEST(MineSweeperGenerator, gives_up_on_impossible_density)
+{
+   // So dense that the solver clears no layout from the start plot, none in 200000 tried
+   MineSweeper::NoGuessGenerator<9,9> generator(60, 1, 1, 7);
+   generator.setMaxAttempts(200);
+
+   MineSweeper::Layout<9,9> layout = generator.getLayout();
+
+   EXPECT_FALSE(layout.no_guess);
+   EXPECT_EQ(60u, layout.mines.count());
+   EXPECT_FALSE(layout.mines.test(layout.start_x, layout.start_y));
+
+   // The game still starts, from a safe plot
+   MineSweeper::Game<9,9> game(60);
+   EXPECT_FALSE(generator.reset(game));
+   EXPECT_EQ(MineSweeper::CLEARING, game.getProgress());
+}
@@ -0,0 +1,254 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 John D. Haughton
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//------------------------------------------------------------------------------
+
+
+
+#include <cstdio>
+#include <vector>
+
+#include "../MineSweeperGame.h"
+#include "../MineSweeperLog.h"
+
+#include "STB/Test.h"
+
+using Expert = MineSweeper::Game<30,16>;
+
+static const char* LOG_FILE = "testMineSweeperLog.mslog";
+
+static bool sameState(const Expert& a, const Expert& b)
+{
+   if((a.getProgress() != b.getProgress()) || (a.getNumberOfFlags() != b.getNumberOfFlags()) ||
+      (a.getNumberOfTicks() != b.getNumberOfTicks()))
+   {
+      return false;
+   }
+
+   for(unsigned y = 0; y < 16; ++y)
+   {
+      for(unsigned x = 0; x < 30; ++x)
+      {
+         bool mine_a, mine_b;
+         if(a.getPlotState(x, y, mine_a) != b.getPlotState(x, y, mine_b)) return false;
+         if(mine_a != mine_b) return false;
+      }
+   }
+
+   return true;
+}
+
+TEST(MineSweeperLog, varint)
+{
+   std::vector<uint8_t> buffer;
+
+   const uint64_t values[] = {0, 1, 127, 128, 300, 16383, 16384, ~uint64_t(0)};
+
+   for(uint64_t value : values) MineSweeper::Log::putVarint(buffer, value);
+
+   const uint8_t* ptr = buffer.data();
+   const uint8_t* end = ptr + buffer.size();
+
+   for(uint64_t expected : values)
+   {
+      uint64_t value;
+      EXPECT_TRUE(MineSweeper::Log::getVarint(ptr, end, value));
+      EXPECT_EQ(expected, value);
+   }
+
+   uint64_t value;
+   EXPECT_FALSE(MineSweeper::Log::getVarint(ptr, end, value));
+
+   // truncated
+   ptr = buffer.data() + buffer.size() - 1;
+   EXPECT_FALSE(MineSweeper::Log::getVarint(ptr, ptr + 0, value));
+}
+
+TEST(MineSweeperLog, record_and_replay)
+{
+   remove(LOG_FILE);
+
+   const unsigned GAMES = 5;
+
+   // States of the live games every few moves
+   std::vector<std::vector<Expert>> history(GAMES);
+
+   {
+      MineSweeper::LogWriter writer(LOG_FILE);
+      EXPECT_TRUE(writer.isOpen());
+
+      Expert                        game(99);
+      MineSweeper::Recorder<Expert> recorder(game, writer);
+      MineSweeper::Random           random(7);
+
+      recorder.setSafeZone(MineSweeper::SAFE_NEIGHBOURHOOD);
+
+      for(unsigned g = 0; g < GAMES; ++g)
+      {
+         recorder.reset(1000 + g);
+         history[g].push_back(game);
+
+         bool ticking = false;
+
+         for(unsigned move = 1; game.getProgress() != MineSweeper::DETONATED && move < 200; ++move)
+         {
+            unsigned x = random.below(30);
+            unsigned y = random.below(16);
+
+            switch(random.below(4))
+            {
+            case 0:
+               recorder.plantUnplantFlag(x, y);
+               ticking = false;
+               break;
+
+            case 1:
+               recorder.tick();
+               recorder.tick();
+
+               // consecutive ticks are logged as one move
+               if(ticking) history[g].pop_back();
+               ticking = true;
+               break;
+
+            default:
+               recorder.digHole(x, y);
+               ticking = false;
+               break;
+            }
+
+            history[g].push_back(game);
+         }
+      }
+   }
+
+   MineSweeper::LogFile file(LOG_FILE);
+   EXPECT_TRUE(file.isValid());
+
+   MineSweeper::Replayer<Expert> replayer(file.begin(), file.end(), /* checkpoint_interval */ 16);
+   EXPECT_EQ(GAMES, replayer.getNumberOfGames());
+
+   Expert game(99);
+
+   for(unsigned g = 0; g < GAMES; ++g)
+   {
+      EXPECT_EQ(1000u + g, replayer.getInfo(g).seed);
+      EXPECT_EQ(history[g].size() - 1, replayer.getNumberOfMoves(g));
+
+      // In reverse so that later replays start from checkpoints
+      for(size_t move = history[g].size(); move-- > 0;)
+      {
+         EXPECT_TRUE(replayer.replay(game, g, move));
+         EXPECT_TRUE(sameState(history[g][move], game));
+      }
+   }
+
+   // A game of the wrong size or with the wrong number of mines is refused
+   MineSweeper::Game<16,16> intermediate(99);
+   MineSweeper::Replayer<MineSweeper::Game<16,16>> wrong_size(file.begin(), file.end());
+   EXPECT_FALSE(wrong_size.replay(intermediate, 0));
+
+   Expert wrong_mines(40);
+   EXPECT_FALSE(replayer.replay(wrong_mines, 0, 0));
+
+   remove(LOG_FILE);
+}
+
+TEST(MineSweeperLog, append_and_truncate)
+{
+   remove(LOG_FILE);
+
+   for(unsigned g = 0; g < 2; ++g)
+   {
+      MineSweeper::LogWriter        writer(LOG_FILE);
+      Expert                        game(99);
+      MineSweeper::Recorder<Expert> recorder(game, writer);
+
+      recorder.reset(g);
+      recorder.digHole(15, 8);
+      recorder.digHole(1000 % 30, 1000 / 30 % 16);
+   }
+
+   // Chop the last byte off a multi-byte record
+   FILE* fp = fopen(LOG_FILE, "ab");
+   EXPECT_TRUE(fp != nullptr);
+   fputc(0x80, fp);
+   fclose(fp);
+
+   MineSweeper::LogFile file(LOG_FILE);
+   EXPECT_TRUE(file.isValid());
+
+   MineSweeper::Replayer<Expert> replayer(file.begin(), file.end());
+   EXPECT_EQ(2u, replayer.getNumberOfGames());
+   EXPECT_EQ(2u, replayer.getNumberOfMoves(1));
+
+   remove(LOG_FILE);
+}
+
+TEST(MineSweeperLog, corrupt_moves)
+{
+   std::vector<uint8_t> buffer;
+
+   MineSweeper::Log::GameInfo info;
+   info.width  = 30;
+   info.height = 16;
+   info.mines  = 99;
+   info.seed   = 1;
+
+   auto putGame = [&]()
+   {
+      MineSweeper::Log::putVarint(buffer, (uint64_t(info.safe_zone) << 2) | MineSweeper::Log::OP_GAME);
+      MineSweeper::Log::putVarint(buffer, info.width);
+      MineSweeper::Log::putVarint(buffer, info.height);
+      MineSweeper::Log::putVarint(buffer, info.mines);
+      MineSweeper::Log::putVarint(buffer, info.seed);
+   };
+
+   // dig just off the end of the board
+   putGame();
+   MineSweeper::Log::putVarint(buffer, (uint64_t(30 * 16) << 2) | MineSweeper::Log::OP_DIG);
+
+   // flag at a huge plot index
+   putGame();
+   MineSweeper::Log::putVarint(buffer, (~uint64_t(0) << 2) | MineSweeper::Log::OP_FLAG);
+
+   // a run of ticks that would take forever to replay
+   putGame();
+   MineSweeper::Log::putVarint(buffer, (~uint64_t(0) >> 2 << 2) | MineSweeper::Log::OP_TICK);
+
+   // well formed
+   putGame();
+   MineSweeper::Log::putVarint(buffer, (uint64_t(30 * 16 - 1) << 2) | MineSweeper::Log::OP_DIG);
+   MineSweeper::Log::putVarint(buffer, (uint64_t(3) << 2) | MineSweeper::Log::OP_TICK);
+
+   MineSweeper::Replayer<Expert> replayer(buffer.data(), buffer.data() + buffer.size());
+   EXPECT_EQ(4u, replayer.getNumberOfGames());
+
+   Expert game(99);
+
+   for(size_t g = 0; g < 3; ++g)
+   {
+      EXPECT_FALSE(replayer.isReplayable(g));
+      EXPECT_FALSE(replayer.replay(game, g));
+   }
+
+   EXPECT_TRUE(replayer.isReplayable(3));
+   EXPECT_TRUE(replayer.replay(game, 3));
+}
@@ -0,0 +1,105 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 John D. Haughton
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//------------------------------------------------------------------------------
+
+
+#include <cstdlib>
+
+#include "../MineSweeperPackedGame.h"
+
+#include "STB/Test.h"
+
+static const unsigned WIDTH  = 30;
+static const unsigned HEIGHT = 16;
+static const unsigned MINES  = 40;
+
+using Reference = MineSweeper::Game<WIDTH,HEIGHT>;
+using Packed    = MineSweeper::PackedGame<WIDTH,HEIGHT>;
+
+static bool sameState(const Reference& ref, const Packed& packed)
+{
+   if((ref.getProgress() != packed.getProgress()) ||
+      (ref.getNumberOfFlags() != packed.getNumberOfFlags()))
+   {
+      return false;
+   }
+
+   for(unsigned y = 0; y < HEIGHT; ++y)
+   {
+      for(unsigned x = 0; x < WIDTH; ++x)
+      {
+         bool ref_mine, packed_mine;
+
+         if((ref.getPlotState(x, y, ref_mine) != packed.getPlotState(x, y, packed_mine)) ||
+            (ref_mine != packed_mine) ||
+            (ref.getNumberOfAdjacentMines(x, y) != packed.getNumberOfAdjacentMines(x, y)))
+         {
+            return false;
+         }
+      }
+   }
+
+   return true;
+}
+
+TEST(MineSweeperPackedGame, size)
+{
+   // three bit boards plus the counters and the random generator state
+   EXPECT_TRUE(sizeof(Packed) <= 3 * sizeof(MineSweeper::BitBoard<WIDTH,HEIGHT>) +
+                                 sizeof(MineSweeper::Random) + 32);
+}
+
+TEST(MineSweeperPackedGame, play)
+{
+   for(unsigned seed = 1; seed <= 20; ++seed)
+   {
+      // vary the safe zone as the re-plant must match too
+      MineSweeper::SafeZone zone = seed % 2 ? MineSweeper::SAFE_PLOT
+                                            : MineSweeper::SAFE_NEIGHBOURHOOD;
+
+      Reference ref{MINES, seed};
+      Packed packed{MINES, seed};
+
+      ref.setSafeZone(zone);
+      packed.setSafeZone(zone);
+
+      EXPECT_TRUE(sameState(ref, packed));
+
+      for(unsigned move = 0; move < 200; ++move)
+      {
+         unsigned x = rand() % WIDTH;
+         unsigned y = rand() % HEIGHT;
+
+         if((move % 5) == 4)
+         {
+            ref.plantUnplantFlag(x, y);
+            packed.plantUnplantFlag(x, y);
+         }
+         else
+         {
+            ref.digHole(x, y);
+            packed.digHole(x, y);
+         }
+
+         EXPECT_TRUE(sameState(ref, packed));
+      }
+   }
+}
@@ -0,0 +1,184 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 John D. Haughton
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//------------------------------------------------------------------------------
+
+
+#include <cmath>
+#include <vector>
+
+#include "../MineSweeperProbability.h"
+#include "../MineSweeperSolver.h"
+
+#include "STB/Test.h"
+
+static bool near(double a, double b) { return std::fabs(a - b) < 1e-9; }
+
+TEST(MineSweeperProbability, untouched_board)
+{
+   MineSweeper::Game<9,9>        game{/* num_of_mines */ 10};
+   MineSweeper::Probability<9,9> probability;
+
+   EXPECT_TRUE(probability.solve(game));
+   EXPECT_TRUE(near(probability.getProbability(4, 4), 10.0 / 81.0));
+   EXPECT_EQ(probability.getNumberOfComponents(), 0);
+}
+
+TEST(MineSweeperProbability, agrees_with_solver)
+{
+   MineSweeper::Solver<30,16>      solver;
+   MineSweeper::Probability<30,16> probability;
+
+   for(unsigned seed = 1; seed <= 50; ++seed)
+   {
+      MineSweeper::Game<30,16> game{/* num_of_mines */ 99, seed};
+
+      game.setSafeZone(MineSweeper::SAFE_NEIGHBOURHOOD);
+      game.digHole(15, 8);
+
+      EXPECT_TRUE(probability.solve(game));
+
+      double expected_mines = 0.0;
+
+      for(unsigned y = 0; y < 16; ++y)
+      {
+         for(unsigned x = 0; x < 30; ++x)
+         {
+            bool mine;
+            if(game.getPlotState(x, y, mine) == MineSweeper::UNDUG)
+            {
+               expected_mines += probability.getProbability(x, y);
+            }
+         }
+      }
+
+      // All the mines are accounted for
+      EXPECT_TRUE(std::fabs(expected_mines - 99) < 1e-6);
+
+      // Certainties found by the solver are certainties here too
+      solver.solve(game);
+      solver.getSafe().forEach([&](unsigned x, unsigned y)
+      {
+         EXPECT_TRUE(near(probability.getProbability(x, y), 0.0));
+      });
+      solver.getMines().forEach([&](unsigned x, unsigned y)
+      {
+         EXPECT_TRUE(near(probability.getProbability(x, y), 1.0));
+      });
+   }
+}
+
+TEST(MineSweeperProbability, single_constraint)
+{
+   //    M ? ?    the only mine is at (0,0)
+   //    1 ? ?
+   MineSweeper::Game<3,2> game{/* num_of_mines */ 1, 1};
+
+   for(uint64_t seed = 1; seed < 10000; ++seed)
+   {
+      game.reset(seed);
+
+      bool mine;
+      game.getPlotState(0, 0, mine);
+      if(mine) break;
+   }
+
+   game.digHole(0, 1);
+
+   MineSweeper::Probability<3,2> probability;
+
+   EXPECT_TRUE(probability.solve(game));
+
+   // The 1 sees three undug plots, so the one mine is equally likely to be in
+   // any of them and cannot be any further away
+   EXPECT_TRUE(near(probability.getProbability(0, 0), 1.0 / 3));
+   EXPECT_TRUE(near(probability.getProbability(1, 0), 1.0 / 3));
+   EXPECT_TRUE(near(probability.getProbability(1, 1), 1.0 / 3));
+   EXPECT_TRUE(near(probability.getProbability(2, 0), 0.0));
+   EXPECT_TRUE(near(probability.getProbability(2, 1), 0.0));
+}
+
+TEST(MineSweeperProbability, brute_force)
+{
+   // Compare with counting every layout consistent with the visible state
+   const unsigned W = 6;
+   const unsigned H = 4;
+   const unsigned N = 5;
+
+   MineSweeper::Probability<W,H> probability;
+
+   for(unsigned seed = 1; seed <= 20; ++seed)
+   {
+      MineSweeper::Game<W,H> game{N, seed};
+      game.digHole(seed % W, seed % H);
+
+      if(game.getProgress() != MineSweeper::CLEARING) continue;
+
+      EXPECT_TRUE(probability.solve(game));
+
+      std::vector<unsigned> unknown;
+      for(unsigned i = 0; i < W * H; ++i)
+      {
+         bool mine;
+         if(game.getPlotState(i % W, i / W, mine) == MineSweeper::UNDUG) unknown.push_back(i);
+      }
+
+      double              layouts = 0;
+      std::vector<double> mined(W * H, 0.0);
+
+      for(uint32_t bits = 0; bits < (1u << unknown.size()); ++bits)
+      {
+         if(unsigned(__builtin_popcount(bits)) != N) continue;
+
+         bool is_mine[W * H] = {};
+         for(unsigned i = 0; i < unknown.size(); ++i) is_mine[unknown[i]] = (bits >> i) & 1;
+
+         bool consistent = true;
+         for(unsigned i = 0; consistent && (i < W * H); ++i)
+         {
+            bool mine;
+            if(game.getPlotState(i % W, i / W, mine) != MineSweeper::HOLE) continue;
+
+            unsigned count = 0;
+            for(signed dy = -1; dy <= 1; ++dy)
+            {
+               for(signed dx = -1; dx <= 1; ++dx)
+               {
+                  signed x = signed(i % W) + dx;
+                  signed y = signed(i / W) + dy;
+                  if((x >= 0) && (x < signed(W)) && (y >= 0) && (y < signed(H)) && is_mine[y * W + x])
+                     ++count;
+               }
+            }
+            consistent = count == game.getNumberOfAdjacentMines(i % W, i / W);
+         }
+
+         if(!consistent) continue;
+
+         layouts += 1;
+         for(unsigned i : unknown) if(is_mine[i]) mined[i] += 1;
+      }
+
+      for(unsigned i : unknown)
+      {
+         EXPECT_TRUE(std::fabs(probability.getProbability(i % W, i / W) - mined[i] / layouts) < 1e-9);
+      }
+   }
+}
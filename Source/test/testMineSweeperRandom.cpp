@@ -0,0 +1,118 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 John D. Haughton
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//------------------------------------------------------------------------------
+
+
+#include <vector>
+
+#include "../MineSweeperRandom.h"
+#include "../MineSweeperGame.h"
+
+#include "STB/Test.h"
+
+TEST(MineSweeperRandom, seed)
+{
+   MineSweeper::Random a{42};
+   MineSweeper::Random b{42};
+   MineSweeper::Random c{43};
+
+   bool all_same = true;
+   bool any_same = false;
+
+   for(unsigned i = 0; i < 100; ++i)
+   {
+      uint64_t value = a();
+      all_same = all_same && (value == b());
+      any_same = any_same || (value == c());
+   }
+
+   EXPECT_TRUE(all_same);
+   EXPECT_FALSE(any_same);
+
+   for(unsigned i = 0; i < 1000; ++i)
+   {
+      EXPECT_TRUE(a.below(7) < 7);
+   }
+}
+
+TEST(MineSweeperRandom, plantMines)
+{
+   MineSweeper::Random random{1};
+
+   uint64_t zone[9];
+   unsigned n = MineSweeper::getSafeZone(MineSweeper::SAFE_NEIGHBOURHOOD, 0, 1, 5, 4, zone);
+
+   EXPECT_EQ(n, 6);
+   EXPECT_EQ(zone[0], 0);
+   EXPECT_EQ(zone[5], 11);
+
+   // Every plot but the safe zone should be mined
+   std::vector<bool> mined(20, false);
+
+   MineSweeper::plantMines(random, 20, 20 - n, zone, n,
+                           [&](uint64_t index) { return bool(mined[index]); },
+                           [&](uint64_t index) { EXPECT_FALSE(mined[index]); mined[index] = true; });
+
+   for(unsigned i = 0; i < 20; ++i)
+   {
+      bool in_zone = (i % 5 <= 1) && (i / 5 <= 2);
+      EXPECT_EQ(mined[i], !in_zone);
+   }
+}
+
+TEST(MineSweeperRandom, first_dig)
+{
+   // Nearly full board, the first dig must still be safe
+   for(unsigned seed = 1; seed <= 20; ++seed)
+   {
+      MineSweeper::Game<9,9> game{/* num_of_mines */ 72, seed};
+
+      game.setSafeZone(MineSweeper::SAFE_NEIGHBOURHOOD);
+      game.digHole(4, 4);
+
+      EXPECT_EQ(game.getProgress(), MineSweeper::CLEARING);
+
+      for(unsigned y = 3; y <= 5; ++y)
+      {
+         for(unsigned x = 3; x <= 5; ++x)
+         {
+            bool mine;
+            EXPECT_EQ(game.getPlotState(x, y, mine), MineSweeper::HOLE);
+            EXPECT_FALSE(mine);
+         }
+      }
+   }
+
+   // Same seed, same layout
+   MineSweeper::Game<9,9> a{10, 7};
+   MineSweeper::Game<9,9> b{10, 7};
+
+   for(unsigned y = 0; y < 9; ++y)
+   {
+      for(unsigned x = 0; x < 9; ++x)
+      {
+         bool mine_a, mine_b;
+         a.getPlotState(x, y, mine_a);
+         b.getPlotState(x, y, mine_b);
+         EXPECT_EQ(mine_a, mine_b);
+      }
+   }
+}
@@ -0,0 +1,319 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 John D. Haughton
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//------------------------------------------------------------------------------
+
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../MineSweeperServer.h"
+
+#include "STB/Test.h"
+
+namespace Protocol = MineSweeper::Protocol;
+
+//! Send one request to a shard and decode the response
+static Protocol::Response call(MineSweeper::Shard&    shard,
+                               const Protocol::Request& request,
+                               std::vector<uint8_t>*   board = nullptr,
+                               uint32_t                owner = 0)
+{
+   uint8_t buffer[Protocol::REQUEST_SIZE];
+   request.encode(buffer);
+
+   std::vector<uint8_t> out;
+   shard.handle(buffer, out, owner);
+
+   Protocol::Response response;
+   response.decode(out.data());
+
+   if(board != nullptr) board->assign(out.begin() + Protocol::RESPONSE_SIZE, out.end());
+
+   return response;
+}
+
+static Protocol::Request request(uint8_t op, uint32_t session, uint8_t x = 0, uint8_t y = 0)
+{
+   Protocol::Request request;
+   request.op      = op;
+   request.session = session;
+   request.x       = x;
+   request.y       = y;
+   return request;
+}
+
+static Protocol::Request newGame(uint8_t level, uint32_t seed)
+{
+   Protocol::Request request;
+   request.op    = Protocol::NEW;
+   request.level = level;
+   request.seed  = seed;
+   return request;
+}
+
+TEST(MineSweeperServer, protocol_round_trip)
+{
+   Protocol::Request request;
+   request.op      = Protocol::DIG;
+   request.level   = 3;
+   request.x       = 29;
+   request.y       = 15;
+   request.session = 0x12345678;
+   request.seed    = 0x9ABCDEF0;
+
+   uint8_t buffer[Protocol::REQUEST_SIZE];
+   request.encode(buffer);
+
+   // Little endian on the wire whatever the host
+   EXPECT_EQ(0x78, buffer[4]);
+   EXPECT_EQ(0x12, buffer[7]);
+
+   Protocol::Request decoded;
+   decoded.decode(buffer);
+
+   EXPECT_EQ(request.op, decoded.op);
+   EXPECT_EQ(request.level, decoded.level);
+   EXPECT_EQ(request.x, decoded.x);
+   EXPECT_EQ(request.y, decoded.y);
+   EXPECT_EQ(request.session, decoded.session);
+   EXPECT_EQ(request.seed, decoded.seed);
+
+   Protocol::Response response;
+   response.status   = Protocol::FULL;
+   response.progress = MineSweeper::CLEARED;
+   response.flags    = 99;
+   response.session  = 0xCAFE0001;
+   response.encode(buffer);
+
+   Protocol::Response decoded_response;
+   decoded_response.decode(buffer);
+
+   EXPECT_EQ(response.status, decoded_response.status);
+   EXPECT_EQ(response.progress, decoded_response.progress);
+   EXPECT_EQ(response.flags, decoded_response.flags);
+   EXPECT_EQ(response.session, decoded_response.session);
+}
+
+TEST(MineSweeperServer, session_matches_game)
+{
+   MineSweeper::Shard            shard;
+   MineSweeper::Game<30, 16>     game{/* num_of_mines */ 99};
+   MineSweeper::Random           random{3};
+   std::vector<uint8_t>          board;
+
+   Protocol::Response response = call(shard, newGame(3, 42));
+   EXPECT_EQ(Protocol::OK, response.status);
+   EXPECT_EQ(MineSweeper::RESET, response.progress);
+   EXPECT_EQ(1u, shard.getNumberOfSessions());
+
+   uint32_t session = response.session;
+   game.reset(42);
+
+   while(game.getProgress() != MineSweeper::DETONATED)
+   {
+      uint8_t x = uint8_t(random.below(30));
+      uint8_t y = uint8_t(random.below(16));
+
+      if(random.below(4) == 0)
+      {
+         game.plantUnplantFlag(x, y);
+         response = call(shard, request(Protocol::FLAG, session, x, y));
+      }
+      else
+      {
+         game.digHole(x, y);
+         response = call(shard, request(Protocol::DIG, session, x, y));
+      }
+
+      EXPECT_EQ(Protocol::OK, response.status);
+      EXPECT_EQ(game.getProgress(), response.progress);
+      EXPECT_EQ(game.getNumberOfFlags(), response.flags);
+   }
+
+   response = call(shard, request(Protocol::STATE, session), &board);
+   EXPECT_EQ(Protocol::getBoardBytes(3), board.size());
+
+   for(unsigned i = 0; i < 30 * 16; ++i)
+   {
+      unsigned x    = i % 30;
+      unsigned y    = i / 30;
+      uint8_t  code = (board[i / 2] >> ((i & 1) * 4)) & 0xF;
+
+      bool mine;
+      switch(game.getPlotState(x, y, mine))
+      {
+      case MineSweeper::UNDUG:     EXPECT_EQ(Protocol::CODE_UNDUG, code);     break;
+      case MineSweeper::FLAG:      EXPECT_EQ(Protocol::CODE_FLAG, code);      break;
+      case MineSweeper::EXPLOSION: EXPECT_EQ(Protocol::CODE_EXPLOSION, code); break;
+      case MineSweeper::HOLE:
+         EXPECT_EQ(mine ? Protocol::CODE_MINE : game.getNumberOfAdjacentMines(x, y), code);
+         break;
+      }
+   }
+
+   response = call(shard, request(Protocol::CLOSE, session));
+   EXPECT_EQ(Protocol::OK, response.status);
+   EXPECT_EQ(0u, shard.getNumberOfSessions());
+
+   response = call(shard, request(Protocol::DIG, session));
+   EXPECT_EQ(Protocol::NO_SESSION, response.status);
+}
+
+TEST(MineSweeperServer, bad_requests)
+{
+   MineSweeper::Shard shard{/* index */ 1, /* max_sessions */ 2};
+
+   EXPECT_EQ(Protocol::BAD_REQUEST, call(shard, newGame(0, 1)).status);
+   EXPECT_EQ(Protocol::BAD_REQUEST, call(shard, newGame(4, 1)).status);
+
+   uint32_t session = call(shard, newGame(1, 1)).session;
+   EXPECT_EQ(1u, session & 0xFF);
+
+   EXPECT_EQ(Protocol::BAD_REQUEST, call(shard, request(Protocol::DIG, session, 9, 0)).status);
+   EXPECT_EQ(Protocol::BAD_REQUEST, call(shard, request(Protocol::FLAG, session, 0, 9)).status);
+   EXPECT_EQ(Protocol::BAD_REQUEST, call(shard, request(99, session)).status);
+
+   // Sessions of another shard, and session 0, are not found here
+   EXPECT_EQ(Protocol::NO_SESSION, call(shard, request(Protocol::DIG, session & ~0xFFu)).status);
+   EXPECT_EQ(Protocol::NO_SESSION, call(shard, request(Protocol::DIG, 0)).status);
+
+   EXPECT_EQ(Protocol::OK, call(shard, newGame(2, 1)).status);
+   EXPECT_EQ(Protocol::FULL, call(shard, newGame(2, 1)).status);
+
+   EXPECT_EQ(Protocol::OK, call(shard, request(Protocol::CLOSE, session)).status);
+   EXPECT_EQ(Protocol::OK, call(shard, newGame(3, 1)).status);
+}
+
+TEST(MineSweeperServer, session_ids)
+{
+   MineSweeper::Shard shard{/* index */ 3};
+
+   uint32_t first = call(shard, newGame(1, 1)).session;
+   EXPECT_EQ(Protocol::OK, call(shard, request(Protocol::CLOSE, first)).status);
+
+   // The slot is reused with a new id, the old id is not found
+   uint32_t second = call(shard, newGame(1, 1)).session;
+   EXPECT_NE(first, second);
+   EXPECT_EQ(Protocol::NO_SESSION, call(shard, request(Protocol::DIG, first)).status);
+   EXPECT_EQ(Protocol::OK, call(shard, request(Protocol::DIG, second)).status);
+
+   // Only the connection that opened a session can use it
+   EXPECT_EQ(Protocol::NO_SESSION, call(shard, request(Protocol::DIG, second), nullptr, 7).status);
+   EXPECT_EQ(Protocol::NO_SESSION, call(shard, request(Protocol::CLOSE, second), nullptr, 7).status);
+
+   uint32_t other = call(shard, newGame(2, 1), nullptr, 7).session;
+   EXPECT_EQ(Protocol::OK, call(shard, request(Protocol::DIG, other), nullptr, 7).status);
+   EXPECT_EQ(Protocol::NO_SESSION, call(shard, request(Protocol::DIG, other)).status);
+
+   // The generation wraps round without ever making id 0
+   for(unsigned i = 0; i < 1000; ++i)
+   {
+      EXPECT_EQ(Protocol::OK, call(shard, request(Protocol::CLOSE, second)).status);
+      second = call(shard, newGame(1, 1)).session;
+      EXPECT_NE(0u, second);
+   }
+
+   // The session count is capped so that the slot fits in the id
+   MineSweeper::Shard big{/* index */ 0, /* max_sessions */ ~uint32_t(0)};
+   EXPECT_EQ(uint32_t(MineSweeper::Shard::MAX_SESSIONS), big.getMaxSessions());
+}
+
+TEST(MineSweeperServer, pool_reuses_games)
+{
+   MineSweeper::GamePool<MineSweeper::Game<9, 9>> pool{/* num_of_mines */ 10};
+
+   std::vector<MineSweeper::Game<9, 9>*> games;
+
+   for(unsigned i = 0; i < 100; ++i) games.push_back(pool.allocate());
+
+   EXPECT_EQ(128u, pool.getCapacity());
+
+   for(auto* game : games) pool.release(game);
+
+   for(unsigned i = 0; i < 100; ++i) EXPECT_TRUE(pool.allocate() != nullptr);
+
+   EXPECT_EQ(128u, pool.getCapacity());
+}
+
+TEST(MineSweeperServer, socket)
+{
+   std::string path = "/tmp/testMineSweeperServer." + std::to_string(::getpid());
+
+   MineSweeper::Server server{/* shards */ 2};
+   EXPECT_TRUE(server.listen(path.c_str()));
+
+   std::thread thread{[&]{ server.run(); }};
+
+   const unsigned CLIENTS = 4;
+
+   for(unsigned client = 0; client < CLIENTS; ++client)
+   {
+      int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+
+      sockaddr_un addr{};
+      addr.sun_family = AF_UNIX;
+      std::strcpy(addr.sun_path, path.c_str());
+      EXPECT_EQ(0, ::connect(fd, (const sockaddr*)&addr, sizeof(addr)));
+
+      auto readAll = [fd](uint8_t* buffer, size_t size)
+      {
+         for(size_t got = 0; got < size;)
+         {
+            ssize_t n = ::read(fd, buffer + got, size - got);
+            if(n <= 0) return false;
+            got += n;
+         }
+         return true;
+      };
+
+      // Requests are pipelined, the session is learnt from the first response
+      uint8_t buffer[Protocol::REQUEST_SIZE * 2];
+      newGame(2, client).encode(buffer);
+      EXPECT_EQ(ssize_t(Protocol::REQUEST_SIZE), ::write(fd, buffer, Protocol::REQUEST_SIZE));
+
+      uint8_t reply[Protocol::RESPONSE_SIZE * 2 + 128];
+      EXPECT_TRUE(readAll(reply, Protocol::RESPONSE_SIZE));
+
+      Protocol::Response response;
+      response.decode(reply);
+      EXPECT_EQ(Protocol::OK, response.status);
+
+      request(Protocol::DIG, response.session, 8, 8).encode(buffer);
+      request(Protocol::STATE, response.session).encode(buffer + Protocol::REQUEST_SIZE);
+      EXPECT_EQ(ssize_t(sizeof(buffer)), ::write(fd, buffer, sizeof(buffer)));
+
+      EXPECT_TRUE(readAll(reply, Protocol::RESPONSE_SIZE * 2 + Protocol::getBoardBytes(2)));
+
+      response.decode(reply);
+      EXPECT_EQ(Protocol::OK, response.status);
+      EXPECT_EQ(MineSweeper::CLEARING, response.progress);
+
+      // The plot dug first is a hole
+      uint8_t code = reply[Protocol::RESPONSE_SIZE * 2 + (8 * 16 + 8) / 2] & 0xF;
+      EXPECT_TRUE(code <= 8);
+
+      ::close(fd);
+   }
+
+   server.stop();
+   thread.join();
+}
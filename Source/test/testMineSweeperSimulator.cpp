@@ -0,0 +1,71 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 John D. Haughton
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//------------------------------------------------------------------------------
+
+
+#include "../MineSweeperSimulator.h"
+
+#include "STB/Test.h"
+
+using SmallGame = MineSweeper::Game<9,9>;
+
+static MineSweeper::Simulator<SmallGame> newSimulator(unsigned threads)
+{
+   return MineSweeper::Simulator<SmallGame>(
+      []{ return std::unique_ptr<SmallGame>(new SmallGame(10)); },
+      []{ return std::unique_ptr<MineSweeper::Player<SmallGame>>(
+             new MineSweeper::RandomPlayer<SmallGame>); },
+      threads);
+}
+
+TEST(MineSweeperSimulator, histogram)
+{
+   MineSweeper::Histogram histogram;
+
+   for(uint64_t ns = 1; ns <= 1000; ++ns)
+   {
+      histogram.add(ns);
+   }
+
+   // Buckets are within 1/8th of the value
+   uint64_t p50 = histogram.getPercentile(50);
+   EXPECT_TRUE((p50 >= 500) && (p50 <= 500 + 500 / 8));
+
+   uint64_t p99 = histogram.getPercentile(99);
+   EXPECT_TRUE((p99 >= 990) && (p99 <= 990 + 990 / 8));
+}
+
+TEST(MineSweeperSimulator, threads)
+{
+   const uint64_t GAMES = 2000;
+
+   MineSweeper::SimulationResult one  = newSimulator(1).run(GAMES, 1);
+   MineSweeper::SimulationResult four = newSimulator(4).run(GAMES, 1);
+
+   EXPECT_EQ(one.games, GAMES);
+   EXPECT_EQ(four.games, GAMES);
+   EXPECT_EQ(one.stalls, 0);
+
+   // Each game is seeded by its number so the thread count makes no difference
+   EXPECT_EQ(one.wins, four.wins);
+   EXPECT_EQ(one.revealed_plots, four.revealed_plots);
+   EXPECT_TRUE(one.revealed_plots > 0);
+}
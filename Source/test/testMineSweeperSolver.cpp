@@ -0,0 +1,104 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 John D. Haughton
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//------------------------------------------------------------------------------
+
+
+#include "../MineSweeperSolver.h"
+
+#include "STB/Test.h"
+
+using Expert = MineSweeper::Game<30,16>;
+
+TEST(MineSweeperSolver, deductions_are_sound)
+{
+   MineSweeper::Solver<30,16> solver;
+
+   unsigned cleared = 0;
+
+   for(unsigned seed = 1; seed <= 200; ++seed)
+   {
+      Expert game{/* num_of_mines */ 99, seed};
+
+      game.setSafeZone(MineSweeper::SAFE_NEIGHBOURHOOD);
+      game.digHole(15, 8);
+
+      solver.play(game);
+
+      // Never digs a mine
+      EXPECT_NE(game.getProgress(), MineSweeper::DETONATED);
+
+      // Only flags mines
+      for(unsigned y = 0; y < 16; ++y)
+      {
+         for(unsigned x = 0; x < 30; ++x)
+         {
+            bool mine;
+            if(game.getPlotState(x, y, mine) == MineSweeper::FLAG)
+            {
+               EXPECT_TRUE(mine);
+            }
+         }
+      }
+
+      if(game.getProgress() == MineSweeper::CLEARED) ++cleared;
+   }
+
+   // Some expert boards need no guesses at all
+   EXPECT_TRUE(cleared > 0);
+}
+
+TEST(MineSweeperSolver, subset_rule)
+{
+   // 1-2-1 pattern along an edge, only the subset rule can resolve it
+   //
+   //    ? ? ? ? ?     row 0 : mines at x=1 and x=3
+   //    . 1 2 1 .     row 1 : holes
+   MineSweeper::Game<5,2> game{/* num_of_mines */ 2, 1};
+
+   // Find a seed that gives the 1-2-1 layout
+   for(uint64_t seed = 1; seed < 10000; ++seed)
+   {
+      game.reset(seed);
+
+      bool a, b;
+      game.getPlotState(1, 0, a);
+      game.getPlotState(3, 0, b);
+      if(a && b) break;
+   }
+
+   game.digHole(0, 1);
+   game.digHole(1, 1);
+   game.digHole(2, 1);
+   game.digHole(3, 1);
+   game.digHole(4, 1);
+
+   MineSweeper::Solver<5,2> solver;
+
+   EXPECT_TRUE(solver.solve(game));
+   EXPECT_TRUE(solver.getMines().test(1, 0));
+   EXPECT_TRUE(solver.getMines().test(3, 0));
+   EXPECT_TRUE(solver.getSafe().test(0, 0));
+   EXPECT_TRUE(solver.getSafe().test(2, 0));
+   EXPECT_TRUE(solver.getSafe().test(4, 0));
+
+   solver.apply(game);
+   EXPECT_EQ(game.getProgress(), MineSweeper::CLEARED);
+}
@@ -0,0 +1,112 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 John D. Haughton
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//------------------------------------------------------------------------------
+
+
+#include <cstring>
+#include <string>
+
+#include "../MineSweeperEndless.h"
+#include "../MineSweeperGame.h"
+#include "../MineSweeperStats.h"
+
+#include "STB/Test.h"
+
+namespace Stats = MineSweeper::Stats;
+
+TEST(MineSweeperStats, json)
+{
+   Stats::Snapshot snapshot;
+   snapshot.counter[Stats::DIGS]            = 3;
+   snapshot.counter[Stats::FLOOD_MAX_DEPTH] = 12345678901234ull;
+   snapshot.timer[Stats::REFRESH].count     = 2;
+   snapshot.timer[Stats::REFRESH].total_ns  = 10;
+   snapshot.timer[Stats::REFRESH].max_ns    = 7;
+
+   char   buffer[1024];
+   size_t length = Stats::formatJSON(snapshot, buffer, sizeof(buffer));
+
+   std::string json{buffer, length};
+
+   EXPECT_TRUE(json.find("\"digs\": 3,") != std::string::npos);
+   EXPECT_TRUE(json.find("\"flood_max_depth\": 12345678901234,") != std::string::npos);
+   EXPECT_TRUE(json.find("\"resets\": 0,") != std::string::npos);
+   EXPECT_TRUE(json.find("\"refresh\": {\"count\": 2, \"total_ns\": 10, \"max_ns\": 7}\n") != std::string::npos);
+   EXPECT_EQ('{', json.front());
+   EXPECT_EQ("}\n", json.substr(json.size() - 2));
+
+   // Output is cut short rather than overflowing
+   char small[16];
+   EXPECT_EQ(15u, Stats::formatJSON(snapshot, small, sizeof(small)));
+   EXPECT_EQ(15u, std::strlen(small));
+}
+
+TEST(MineSweeperStats, game_counters)
+{
+   Stats::clear();
+
+   MineSweeper::Game<30, 16> game{/* num_of_mines */ 10, /* seed */ 4};
+   game.digHole(15, 8);
+   game.digHole(15, 8);
+
+   unsigned holes = 0;
+   for(unsigned y = 0; y < 16; ++y)
+   {
+      for(unsigned x = 0; x < 30; ++x)
+      {
+         bool mine;
+         if(game.getPlotState(x, y, mine) == MineSweeper::HOLE) ++holes;
+      }
+   }
+
+   Stats::Snapshot snapshot = Stats::get();
+
+   if(Stats::ENABLED)
+   {
+      EXPECT_EQ(1u, snapshot.counter[Stats::RESETS]);
+      EXPECT_EQ(1u, snapshot.counter[Stats::DIGS]);
+      EXPECT_EQ(holes, snapshot.counter[Stats::CELLS_REVEALED]);
+      EXPECT_TRUE(snapshot.counter[Stats::FLOOD_MAX_DEPTH] >= 1);
+   }
+   else
+   {
+      EXPECT_EQ(0u, snapshot.counter[Stats::DIGS]);
+      EXPECT_EQ(0u, snapshot.counter[Stats::CELLS_REVEALED]);
+      EXPECT_EQ(0u, snapshot.counter[Stats::RESETS]);
+   }
+
+   Stats::clear();
+   EXPECT_EQ(0u, Stats::get().counter[Stats::CELLS_REVEALED]);
+}
+
+TEST(MineSweeperStats, endless_counters)
+{
+   Stats::clear();
+
+   // Digging a plot that is already a hole is not counted, as in Game
+   MineSweeper::EndlessGame game{/* density */ 20, /* seed */ 4};
+   game.digHole(0, 0);
+   game.digHole(0, 0);
+
+   EXPECT_EQ(Stats::ENABLED ? 1u : 0u, Stats::get().counter[Stats::DIGS]);
+
+   Stats::clear();
+}